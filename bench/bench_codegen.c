@@ -0,0 +1,145 @@
+/*
+ * Code generation walk: the explicit-stack evaluateTree() against the
+ * recursive walk it replaced.
+ *
+ *   gcc -O2 -pthread -o bench_codegen bench/bench_codegen.c
+ *   ./bench_codegen [repeats]
+ *
+ * Trees come from the parser: a shallow "mixed" workload from
+ * writeWorkload(), one left-leaning x + x + ... + x line and one
+ * right-leaning x - (x - (... - x)) line of a million operands each.
+ * Both walks run on a thread with a 1 GB stack so that the recursive one
+ * survives the deep trees, and must emit the same instructions. Reports
+ * nanoseconds per tree node for each.
+ */
+#define MINIPROJECT_NO_MAIN
+#include "../miniproject.c"
+#define WORKLOAD_NO_MAIN
+#include "workload.c"
+
+// evaluateTree() as it was, one call per node
+static int evaluateRecursive(Compiler *cc, int root) {
+    BTNode *node = &cc->nodes[root];
+    int retval = 0, lv, rv;
+
+    switch (node->data) {
+        case ID:
+            cc->ID_APPEAR += 1;
+            retval = getval(cc, node->val, cc->rflag);
+            cc->rflag += 1;
+            return retval;
+        case INT:
+            emit(cc, OP_MOV, A_REG, cc->rflag, A_IMM, node->val);
+            cc->rflag += 1;
+            return node->val;
+        case ASSIGN:
+            rv = evaluateRecursive(cc, node->right);
+            return setval(cc, cc->nodes[node->left].val, rv, cc->rflag - 1);
+        default:
+            lv = evaluateRecursive(cc, node->left);
+            rv = evaluateRecursive(cc, node->right);
+            if (node->val == '/' && rv == 0 && cc->ID_APPEAR == 0)
+                err(cc, DIVZERO);
+            emitArith(cc, node->val, cc->rflag - 2, cc->rflag - 1);
+            cc->rflag -= 1;
+            retval = node->val == '/' && rv == 0 ? 0 : calc(node->val, lv, rv);
+            if (node->data == INCDEC || node->data == ADDSUB_ASSIGN)
+                retval = setval(cc, cc->nodes[node->left].val, retval, cc->rflag - 1);
+            return retval;
+    }
+}
+
+static int repeats = 5;
+
+// Keep every tree in the arena, returns how many roots there are
+static int parseAll(Compiler *cc, const Input *in, int *roots) {
+    jmp_buf onError;
+    int count = 0;
+
+    cc->srcBegin = cc->srcCur = in->text;
+    cc->srcEnd = in->text + in->len;
+    cc->onError = &onError;
+    if (setjmp(onError)) {
+        fprintf(stderr, "%s: the workload does not compile\n", in->name);
+        exit(1);
+    }
+    while (!match(cc, ENDFILE)) {
+        if (!match(cc, END))
+            roots[count++] = assign_expr(cc);
+        advance(cc);
+    }
+    cc->onError = NULL;
+    return count;
+}
+
+static void *runBench(void *arg) {
+    Input *inputs = (Input*)arg;
+
+    for (int k = 0; k < 3; k++) {
+        Compiler *cc = newCompiler(NULL);
+        int *roots = (int*)malloc(sizeof(int) * (inputs[k].len + 1));
+        int count = parseAll(cc, &inputs[k], roots);
+        double best[2] = { 1e30, 1e30 };
+
+        // check both walks on every statement, which also assigns the variables
+        for (int i = 0; i < count; i++) {
+            Instr *ref;
+            int n;
+            cc->rflag = cc->ID_APPEAR = cc->codeCount = 0;
+            evaluateTree(cc, roots[i]);
+            n = cc->codeCount;
+            ref = (Instr*)malloc(n * sizeof(Instr));
+            memcpy(ref, cc->code, n * sizeof(Instr));
+            cc->rflag = cc->ID_APPEAR = cc->codeCount = 0;
+            evaluateRecursive(cc, roots[i]);
+            if (cc->codeCount != n || memcmp(ref, cc->code, n * sizeof(Instr)) != 0) {
+                fprintf(stderr, "%s: statement %d differs\n", inputs[k].name, i);
+                exit(1);
+            }
+            free(ref);
+        }
+
+        for (int r = 0; r < repeats; r++) {
+            for (int v = 0; v < 2; v++) {
+                double t0 = now(), t;
+                for (int i = 0; i < count; i++) {
+                    cc->rflag = cc->ID_APPEAR = cc->codeCount = 0;
+                    if (v == 0)
+                        evaluateTree(cc, roots[i]);
+                    else
+                        evaluateRecursive(cc, roots[i]);
+                }
+                t = now() - t0;
+                if (t < best[v])
+                    best[v] = t;
+            }
+        }
+        printf("%-14s %9d nodes  explicit stack %6.2f ns/node  recursive %6.2f ns/node\n",
+               inputs[k].name, cc->nodecount - 1,
+               best[0] * 1e9 / (cc->nodecount - 1), best[1] * 1e9 / (cc->nodecount - 1));
+        free(roots);
+        freeCompiler(cc);
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    Input inputs[3];
+    pthread_attr_t attr;
+    pthread_t thread;
+
+    if (argc > 1)
+        repeats = atoi(argv[1]) > 0 ? atoi(argv[1]) : 1;
+    inputs[0] = makeInput("shallow", INPUT_MIXED);
+    inputs[1] = makeInput("left-leaning", INPUT_LEFT);
+    inputs[2] = makeInput("right-leaning", INPUT_RIGHT);
+
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, (size_t)1 << 30);
+    if (pthread_create(&thread, &attr, runBench, inputs) != 0) {
+        perror("pthread_create");
+        return 1;
+    }
+    pthread_join(thread, NULL);
+    return 0;
+}
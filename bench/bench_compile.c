@@ -0,0 +1,207 @@
+/*
+ * End-to-end compiler benchmark over a fixed set of synthetic workloads.
+ *
+ *   gcc -O2 -pthread -o miniproject miniproject.c
+ *   gcc -O2 -pthread -o bench_compile bench/bench_compile.c
+ *   ./bench_compile [-b ./miniproject] [-r runs] [-s scale] [-o results.json] [-- flags...]
+ *
+ * Every workload of the suite is written to a temporary file with
+ * writeWorkload() and compiled by the binary given with -b (any version
+ * of the compiler, flags after -- are passed on), with its output read
+ * from a pipe. Tokens and statements are counted with the lexer of this
+ * tree, instructions are the lines the compiler printed. The best of
+ * -r runs gives the throughput, peak RSS is the largest ru_maxrss seen.
+ * -s multiplies the statement counts. Results go to stdout as JSON, or
+ * to the -o file.
+ */
+#define MINIPROJECT_NO_MAIN
+#include "../miniproject.c"
+#define WORKLOAD_NO_MAIN
+#include "workload.c"
+
+#include <time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+typedef struct {
+    const char *name;
+    Workload w;
+} Preset;
+
+static const Preset suite[] = {
+    { "mixed",    { 1, 200000, 4, 64, "++--**/&|^", 0, 0 } },
+    { "arith",    { 2, 200000, 3, 16, "+-*", 0, 0 } },
+    { "deep",     { 3, 20000, 12, 64, "++--**/&|^", 0, 0 } },
+    { "manyvars", { 4, 200000, 3, 50000, "++--**/&|^", 0, 0 } },
+    { "parens",   { 5, 50000, 4, 64, "++--**/&|^", 64, 0 } },
+    { "chains",   { 6, 50000, 2, 64, "+-", 0, 64 } },
+};
+
+typedef struct {
+    long bytes;
+    long tokens;
+    long statements;
+    long instructions;
+    double seconds;
+    long peakRss;
+    int status;
+} Result;
+
+// Count tokens (not line ends) and non-empty lines with the lexer
+static void countTokens(const char *path, Result *res) {
+    Compiler *cc = newCompiler(NULL);
+    int inLine = 0;
+    TokenSet tok;
+
+    openInput(cc, path);
+    res->bytes = cc->srcEnd - cc->srcBegin;
+    while ((tok = getToken(cc)) != ENDFILE) {
+        if (tok == END) {
+            res->statements += inLine;
+            inLine = 0;
+        }
+        else {
+            res->tokens++;
+            inLine = 1;
+        }
+    }
+    res->statements += inLine;
+    closeInput(cc);
+    freeCompiler(cc);
+}
+
+// Compile path once with the binary, counting the lines it prints
+static int runOnce(char *const argv[], const char *path, Result *res) {
+    static char buf[1 << 16];
+    struct rusage ru;
+    int fds[2], in, status;
+    long lines = 0;
+    ssize_t n;
+    double t0 = now(), t;
+    pid_t pid;
+
+    if ((in = open(path, O_RDONLY)) < 0 || pipe(fds) != 0) {
+        perror(path);
+        return -1;
+    }
+    pid = fork();
+    if (pid == 0) {
+        dup2(in, 0);
+        dup2(fds[1], 1);
+        close(fds[0]);
+        close(fds[1]);
+        execv(argv[0], argv);
+        perror(argv[0]);
+        _exit(127);
+    }
+    close(in);
+    close(fds[1]);
+    while ((n = read(fds[0], buf, sizeof(buf))) > 0)
+        for (ssize_t i = 0; i < n; i++)
+            lines += buf[i] == '\n';
+    close(fds[0]);
+    if (pid < 0 || wait4(pid, &status, 0, &ru) < 0) {
+        perror("wait4");
+        return -1;
+    }
+    t = now() - t0;
+
+    res->instructions = lines;
+    if (res->seconds == 0 || t < res->seconds)
+        res->seconds = t;
+    if (ru.ru_maxrss > res->peakRss)
+        res->peakRss = ru.ru_maxrss;
+    res->status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    return 0;
+}
+
+static void printJsonString(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            fputc('\\', f);
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+int main(int argc, char *argv[]) {
+    const char *binary = "./miniproject", *outPath = NULL;
+    int runs = 3, nflags = 0;
+    double scale = 1;
+    char **cmd = (char**)calloc(argc + 2, sizeof(char*));
+    char path[] = "/tmp/bench_compile_XXXXXX";
+    FILE *out = stdout;
+    int fd;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--") == 0) {
+            for (i++; i < argc; i++)
+                cmd[1 + nflags++] = argv[i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-b") == 0)
+            binary = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "-r") == 0)
+            runs = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-s") == 0)
+            scale = atof(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-o") == 0)
+            outPath = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [-b binary] [-r runs] [-s scale] [-o file] [-- flags...]\n", argv[0]);
+            return 1;
+        }
+    }
+    cmd[0] = (char*)binary;
+    if (runs < 1)
+        runs = 1;
+    if ((fd = mkstemp(path)) < 0) {
+        perror(path);
+        return 1;
+    }
+    close(fd);
+    if (outPath != NULL && (out = fopen(outPath, "w")) == NULL) {
+        perror(outPath);
+        return 1;
+    }
+
+    fprintf(out, "{\n  \"binary\": ");
+    printJsonString(out, binary);
+    fprintf(out, ",\n  \"flags\": [");
+    for (int i = 0; i < nflags; i++) {
+        fputs(i ? ", " : "", out);
+        printJsonString(out, cmd[1 + i]);
+    }
+    fprintf(out, "],\n  \"runs\": %d,\n  \"workloads\": [\n", runs);
+
+    for (size_t k = 0; k < sizeof(suite) / sizeof(suite[0]); k++) {
+        Workload w = suite[k].w;
+        Result res = { 0 };
+        FILE *f = fopen(path, "w");
+
+        w.statements = (long)(w.statements * scale);
+        writeWorkload(f, &w);
+        fclose(f);
+        countTokens(path, &res);
+        for (int r = 0; r < runs; r++)
+            if (runOnce(cmd, path, &res) != 0)
+                return 1;
+        fprintf(stderr, "%-10s %8.3f s  %6.1f Mtok/s\n", suite[k].name, res.seconds,
+                res.tokens / res.seconds / 1e6);
+
+        fprintf(out, "    {\"name\": \"%s\", \"statements\": %ld, \"tokens\": %ld, \"bytes\": %ld,\n"
+                "     \"exit_status\": %d, \"seconds\": %.6f, \"tokens_per_sec\": %.0f,\n"
+                "     \"statements_per_sec\": %.0f, \"peak_rss_kb\": %ld,\n"
+                "     \"instructions\": %ld, \"instructions_per_statement\": %.3f}%s\n",
+                suite[k].name, res.statements, res.tokens, res.bytes,
+                res.status, res.seconds, res.tokens / res.seconds,
+                res.statements / res.seconds, res.peakRss,
+                res.instructions, res.statements ? (double)res.instructions / res.statements : 0.0,
+                k + 1 < sizeof(suite) / sizeof(suite[0]) ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    unlink(path);
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}
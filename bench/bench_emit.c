@@ -0,0 +1,103 @@
+/*
+ * Output throughput of the instruction emitter.
+ *
+ *   gcc -O2 -pthread -o bench_emit bench/bench_emit.c
+ *   ./bench_emit [instructions]
+ *
+ * Formats a synthetic instruction stream (loads, stores, constants and
+ * arithmetic in roughly the mix evaluateTree() produces) to /dev/null
+ * through flushCode(), and the same stream through stdio printf for
+ * comparison, and reports MB/s for both.
+ */
+#define MINIPROJECT_NO_MAIN
+#include "../miniproject.c"
+#define WORKLOAD_NO_MAIN
+#include "workload.c"
+
+#define CHUNK 65536
+
+static unsigned seed = 12345;
+
+static unsigned nextRand(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+// Fill code[] with n instructions
+static void fillChunk(Compiler *cc, int n) {
+    cc->codeCount = 0;
+    for (int i = 0; i < n; i++) {
+        unsigned r = nextRand();
+        int reg = r % 4;
+        switch ((r >> 4) % 6) {
+            case 0:
+            case 1:
+                emit(cc, OP_MOV, A_REG, reg, A_MEM, (r >> 8) % 64 * 4);
+                break;
+            case 2:
+                emit(cc, OP_MOV, A_REG, reg, A_IMM, (int)(r >> 8) % 100000 - 5000);
+                break;
+            case 3:
+                emit(cc, OP_MOV, A_MEM, (r >> 8) % 64 * 4, A_REG, reg);
+                break;
+            default:
+                emit(cc, (OpCode)(OP_ADD + (r >> 8) % 7), A_REG, reg, A_REG, reg + 1);
+                break;
+        }
+    }
+}
+
+static void printArgStdio(FILE *f, ArgKind k, int v) {
+    if (k == A_REG)
+        fprintf(f, "r%d", v);
+    else if (k == A_MEM)
+        fprintf(f, "[%d]", v);
+    else
+        fprintf(f, "%d", v);
+}
+
+int main(int argc, char *argv[]) {
+    long total = argc > 1 ? atol(argv[1]) : 20000000;
+    char scratch[64];
+    double bytes = 0, t0, tEmit = 0, tStdio = 0;
+    FILE *devnull = fopen("/dev/null", "w");
+    Compiler *cc = newCompiler(NULL);
+
+    cc->outFd = open("/dev/null", O_WRONLY);
+    if (cc->outFd < 0 || devnull == NULL) {
+        perror("/dev/null");
+        return 1;
+    }
+
+    for (long done = 0; done < total; done += CHUNK) {
+        int n = total - done < CHUNK ? (int)(total - done) : CHUNK;
+
+        fillChunk(cc, n);
+        for (int i = 0; i < n; i++)
+            bytes += formatInstr(scratch, &cc->code[i]) - scratch;
+
+        t0 = now();
+        for (int i = 0; i < n; i++) {
+            Instr *in = &cc->code[i];
+            fprintf(devnull, "%s ", opNames[in->op]);
+            printArgStdio(devnull, in->ka, in->a);
+            fputc(' ', devnull);
+            printArgStdio(devnull, in->kb, in->b);
+            fputc('\n', devnull);
+        }
+        tStdio += now() - t0;
+
+        t0 = now();
+        flushCode(cc);
+        tEmit += now() - t0;
+    }
+    t0 = now();
+    flushOutput(cc);
+    fflush(devnull);
+    tEmit += now() - t0;
+
+    printf("%ld instructions, %.1f MB of text\n", total, bytes / 1e6);
+    printf("buffered emitter: %8.3f s  %8.1f MB/s\n", tEmit, bytes / 1e6 / tEmit);
+    printf("stdio printf:     %8.3f s  %8.1f MB/s\n", tStdio, bytes / 1e6 / tStdio);
+    return 0;
+}
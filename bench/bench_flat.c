@@ -0,0 +1,122 @@
+/*
+ * Statement representation: the BTNode arena and evaluateTree() against
+ * the flat postfix arrays of --flat and flatEvaluate().
+ *
+ *   gcc -O2 -pthread -o bench_flat bench/bench_flat.c
+ *   ./bench_flat [both|tree|flat] [repeats]
+ *
+ * Inputs are the same as for bench_codegen: a shallow "mixed" workload
+ * from writeWorkload(), one left-leaning x + x + ... + x line and one
+ * right-leaning x - (x - (... - x)) line of a million operands each.
+ * Every statement is parsed and its code generated, one statement at a
+ * time the way compile() does, and both representations must emit the
+ * same instructions. Reports ticks of statTicks(), TSC cycles on x86-64,
+ * per node for the parse and for the code generation, the best of
+ * repeats. With tree or flat only that one runs, so that each can be
+ * measured on its own, e.g.
+ *
+ *   perf stat -e cache-references,cache-misses,L1-dcache-load-misses ./bench_flat tree
+ *   perf stat -e cache-references,cache-misses,L1-dcache-load-misses ./bench_flat flat
+ */
+#define MINIPROJECT_NO_MAIN
+#include "../miniproject.c"
+#define WORKLOAD_NO_MAIN
+#include "workload.c"
+
+typedef struct {
+    unsigned long long parse;
+    unsigned long long codegen;
+    unsigned long long hash;
+    long nodes;
+} Run;
+
+// Parse and generate every statement of in, flat or not
+static Run runAll(const Input *in, int flat) {
+    Compiler *cc = newCompiler(NULL);
+    Run run = { 0, 0, 0, 0 };
+    jmp_buf onError;
+
+    optFlat = flat;
+    cc->srcBegin = cc->srcCur = in->text;
+    cc->srcEnd = in->text + in->len;
+    cc->onError = &onError;
+    if (setjmp(onError)) {
+        fprintf(stderr, "%s: the workload does not compile\n", in->name);
+        exit(1);
+    }
+    while (!match(cc, ENDFILE)) {
+        if (!match(cc, END)) {
+            unsigned long long t0, t1;
+            int root;
+
+            cc->nodecount = 1;
+            cc->rflag = cc->ID_APPEAR = cc->codeCount = 0;
+            t0 = statTicks();
+            root = assign_expr(cc);
+            t1 = statTicks();
+            if (flat)
+                flatEvaluate(cc);
+            else
+                evaluateTree(cc, root);
+            run.codegen += statTicks() - t1;
+            run.parse += t1 - t0;
+            run.nodes += cc->nodecount - 1;
+            for (int i = 0; i < cc->codeCount; i++) {
+                const Instr *c = &cc->code[i];
+                run.hash = run.hash * 1000003 + c->op * 131 + c->ka * 31 + c->a * 17
+                           + c->kb * 7 + c->b;
+            }
+        }
+        advance(cc);
+    }
+    cc->onError = NULL;
+    freeCompiler(cc);
+    return run;
+}
+
+int main(int argc, char *argv[]) {
+    static const char *names[] = { "tree", "flat" };
+    int repeats = 5, first = 0, last = 1;
+    Input inputs[3];
+
+    if (argc > 1 && strcmp(argv[1], "tree") == 0)
+        last = 0;
+    else if (argc > 1 && strcmp(argv[1], "flat") == 0)
+        first = 1;
+    else if (argc > 1 && strcmp(argv[1], "both") != 0) {
+        fprintf(stderr, "usage: %s [both|tree|flat] [repeats]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2)
+        repeats = atoi(argv[2]) > 0 ? atoi(argv[2]) : 1;
+    inputs[0] = makeInput("shallow", INPUT_MIXED);
+    inputs[1] = makeInput("left-leaning", INPUT_LEFT);
+    inputs[2] = makeInput("right-leaning", INPUT_RIGHT);
+
+    for (int k = 0; k < 3; k++) {
+        Run best[2];
+        long nodes = 0;
+
+        for (int v = first; v <= last; v++) {
+            best[v] = runAll(&inputs[k], v);
+            nodes = best[v].nodes;
+            for (int r = 1; r < repeats; r++) {
+                Run run = runAll(&inputs[k], v);
+                if (run.parse < best[v].parse)
+                    best[v].parse = run.parse;
+                if (run.codegen < best[v].codegen)
+                    best[v].codegen = run.codegen;
+            }
+        }
+        if (first < last && best[0].hash != best[1].hash) {
+            fprintf(stderr, "%s: the flat code differs\n", inputs[k].name);
+            return 1;
+        }
+        printf("%-14s %8ld nodes", inputs[k].name, nodes);
+        for (int v = first; v <= last; v++)
+            printf("  %s parse %5.1f codegen %5.1f", names[v],
+                   (double)best[v].parse / nodes, (double)best[v].codegen / nodes);
+        printf(" ticks/node\n");
+    }
+    return 0;
+}
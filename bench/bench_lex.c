@@ -0,0 +1,115 @@
+/*
+ * Lexer scan: runs of blanks, digits and names a byte at a time against
+ * 16 (SSE2) and 32 (AVX2) bytes at a time, and against the ctype loops
+ * getToken() had before.
+ *
+ *   gcc -O2 -pthread -o bench_lex bench/bench_lex.c
+ *   ./bench_lex [repeats]
+ *
+ * Inputs are the "mixed" workload from writeWorkload(), where almost
+ * every run is a byte or two long, and three made up to have long runs:
+ * names of 24 to 64 characters, numbers of 16 to 48 digits and lines
+ * indented and spaced with 8 to 64 blanks. They are only lexed, not
+ * compiled. Every scan must give the same tokens. Reports input bytes
+ * per tick of statTicks(), a TSC cycle on x86-64, the best of repeats.
+ */
+#define MINIPROJECT_NO_MAIN
+#include "../miniproject.c"
+#define WORKLOAD_NO_MAIN
+#include "workload.c"
+
+// getToken() as it was, the runs only
+static TokenSet getTokenCtype(Compiler *cc) {
+    const char *p = cc->srcCur;
+    int c;
+
+    while (p < cc->srcEnd && (*p == ' ' || *p == '\t'))
+        ++p;
+    cc->lexeme.ptr = p;
+    cc->lexeme.len = 1;
+    if (p >= cc->srcEnd) {
+        cc->lexeme.len = 0;
+        cc->srcCur = p;
+        return ENDFILE;
+    }
+    c = (unsigned char)*p++;
+    cc->srcCur = p;
+    if (isdigit(c)) {
+        while (p < cc->srcEnd && isdigit((unsigned char)*p))
+            ++p;
+        cc->lexeme.len = p - cc->lexeme.ptr;
+        cc->srcCur = p;
+        return INT;
+    }
+    else if (isalpha(c) || c == '_') {
+        while (p < cc->srcEnd && (isalnum((unsigned char)*p) || *p == '_'))
+            ++p;
+        cc->lexeme.len = p - cc->lexeme.ptr;
+        cc->srcCur = p;
+        return ID;
+    }
+    // everything else is one byte long, getToken() knows the rest
+    cc->srcCur = cc->lexeme.ptr;
+    return getToken(cc);
+}
+
+// Lex all of in, returns a hash of the tokens and where they are
+static unsigned long long lexAll(Compiler *cc, const Input *in, int ctype, long *tokens) {
+    unsigned long long h = 0;
+    TokenSet t;
+
+    cc->srcBegin = cc->srcCur = in->text;
+    cc->srcEnd = in->text + in->len;
+    *tokens = 0;
+    while ((t = ctype ? getTokenCtype(cc) : getToken(cc)) != ENDFILE) {
+        h = h * 1000003 + (unsigned)t * 131 + (cc->lexeme.ptr - in->text) * 7 + cc->lexeme.len;
+        (*tokens)++;
+    }
+    return h;
+}
+
+int main(int argc, char *argv[]) {
+    static const char *scans[] = { "ctype", "scalar", "sse2", "avx2" };
+    int repeats = 5, have;
+    Input inputs[4];
+    Compiler *cc = newCompiler(NULL);
+
+    if (argc > 1)
+        repeats = atoi(argv[1]) > 0 ? atoi(argv[1]) : 1;
+    // newCompiler() picked the widest scan there is
+    have = lexScan + 1;
+    inputs[0] = makeInput("mixed", INPUT_MIXED);
+    inputs[1] = makeInput("long names", INPUT_NAMES);
+    inputs[2] = makeInput("long numbers", INPUT_NUMBERS);
+    inputs[3] = makeInput("blanks", INPUT_BLANKS);
+
+    for (int k = 0; k < 4; k++) {
+        unsigned long long ref = 0;
+        long tokens = 0, n;
+
+        lexAll(cc, &inputs[k], 1, &tokens);
+        printf("%-13s %9zu bytes %8ld tokens ", inputs[k].name, inputs[k].len, tokens);
+        for (int v = 0; v <= have; v++) {
+            unsigned long long best = ~0ull, h = 0;
+            if (v > 0)
+                lexScan = v - 1;
+            for (int r = 0; r < repeats; r++) {
+                unsigned long long t0 = statTicks(), t;
+                h = lexAll(cc, &inputs[k], v == 0, &n);
+                t = statTicks() - t0;
+                if (t < best)
+                    best = t;
+            }
+            if (v == 0)
+                ref = h;
+            else if (h != ref) {
+                fprintf(stderr, "%s: the %s scan gives other tokens\n", inputs[k].name, scans[v]);
+                return 1;
+            }
+            printf(" %s %5.2f", scans[v], (double)inputs[k].len / best);
+        }
+        printf(" bytes/tick\n");
+    }
+    freeCompiler(cc);
+    return 0;
+}
@@ -0,0 +1,383 @@
+/*
+ * Regression checks: programs that some combination of flags once
+ * compiled wrong.
+ *
+ *   gcc -O2 -pthread -o miniproject miniproject.c
+ *   gcc -O2 -pthread -o regress bench/regress.c
+ *   ./regress [-b ./miniproject]
+ *
+ * Every case is written to a temporary file and compiled by the binary
+ * given with -b with the flags of the case. Its input is the program
+ * text of the case, the writeWorkload() text of its workload, or, with
+ * terms set, a writeDeep() statement of that many terms, compiled with
+ * the stack the shell gives it. What is checked depends on the kind:
+ *   EXPECT     what it prints and its exit status are the ones expected;
+ *              most use --run, so that the VM also checks the code
+ *              against the values known at compile time
+ *   SAME       it prints the same bytes and exits the same way as with
+ *              the flags in against
+ *   ROUNDTRIP  what it prints, read back by --disasm, is what the flags
+ *              in against print
+ *   SERVE      a server started with its flags replies what the binary
+ *              prints for them, and still answers the next request
+ *   BATCH      every file of files goes in one run, and each <file>.s is
+ *              what the flags in against print for that file alone
+ */
+#define MINIPROJECT_NO_MAIN
+#include "../miniproject.c"
+#define WORKLOAD_NO_MAIN
+#include "workload.c"
+
+#include <sys/wait.h>
+
+enum { EXPECT, SAME, ROUNDTRIP, SERVE, BATCH };
+
+typedef struct {
+    const char *name;
+    int kind;
+    const char *flags[5];
+    const char *against[5];
+    const char *program;
+    const Workload *workload;
+    int shape;
+    int terms;
+    const char *files[4];
+    const char *expect;
+    int status;
+} Case;
+
+// about 3 MB, a dozen -j chunks
+static const Workload chunks = { 1, 60000, 4, 64, "++--**/&|^", 2, 4 };
+
+static const Case cases[] = {
+    // the cycle x <-> y in the epilogue was broken through r2, z's register
+    { .name = "cache swap", .flags = { "--cache", "2", "--run" },
+      .program = "y = 1\nx = 2\nz = 3\ny = y + 1\nx = x + 1\ny = y + x\nx = x + y\n",
+      .expect = "x = 8, y = 5, z = 3\n" },
+    // y / (y - y) went ahead of the load of y, which is not there
+    { .name = "regs notfound", .flags = { "--regs", "3" }, .program = "c += y / (y - y)\n",
+      .expect = "MOV r0 EXIT 1\n" },
+    // passes that recursed once per node ran out of stack
+    { .name = "regs deep", .flags = { "--regs", "3", "--run" }, .shape = DEEP_LEFT, .terms = 100000,
+      .expect = "x = 1, y = 100000, z = 0\n" },
+    { .name = "cse deep", .flags = { "--cse", "--run" }, .shape = DEEP_LEFT, .terms = 100000,
+      .expect = "x = 1, y = 100000, z = 0\n" },
+    { .name = "fold deep left", .flags = { "--fold", "--run" }, .shape = DEEP_LEFT, .terms = 300000,
+      .expect = "x = 1, y = 300000, z = 0\n" },
+    { .name = "fold deep right", .flags = { "--fold", "--run" }, .shape = DEEP_RIGHT, .terms = 300000,
+      .expect = "x = 1, y = 0, z = 0\n" },
+    { .name = "fold deep minus", .flags = { "--fold", "--run" }, .shape = DEEP_NEG, .terms = 300000,
+      .expect = "x = 1, y = -1, z = 0\n" },
+    { .name = "fold deep assign", .flags = { "--fold", "--run" }, .shape = DEEP_ASSIGN, .terms = 300000,
+      .expect = "x = 1, y = 1, z = 0\n" },
+    { .name = "serve fold deep", .kind = SERVE, .flags = { "--fold" }, .shape = DEEP_RIGHT, .terms = 300000 },
+#if defined(__x86_64__)
+    // one push per pending left operand overflowed the native stack
+    { .name = "jit deep left", .flags = { "--jit" }, .shape = DEEP_LEFT, .terms = 300000,
+      .expect = "x = 1, y = 300000, z = 0\n" },
+    { .name = "jit deep right", .flags = { "--jit" }, .shape = DEEP_RIGHT, .terms = 1000000,
+      .expect = "x = 1, y = 0, z = 0\n" },
+#endif
+    // the seams between chunks must not show in the output
+    { .name = "jobs same", .kind = SAME, .flags = { "-j", "4" }, .workload = &chunks },
+    // passes that drop code must keep the values
+    { .name = "dse same", .kind = SAME, .flags = { "--dse", "--run" }, .against = { "--run" },
+      .workload = &chunks },
+    { .name = "fold-program same", .kind = SAME, .flags = { "--fold-program", "--run" },
+      .against = { "--run" }, .workload = &chunks },
+    { .name = "binary roundtrip", .kind = ROUNDTRIP, .flags = { "--emit=binary" }, .workload = &chunks },
+    // an error ends only its own file
+    { .name = "batch error", .kind = BATCH, .flags = { "--batch", "-j", "2" },
+      .files = { "x = 1\ny = x + 2\n", "x = 1\ny = (3\nz = 4\n", "z = 5 * y\nx = z / 0\n" } },
+};
+
+typedef struct {
+    char *text;
+    size_t len;
+} Output;
+
+static void append(Output *out, const char *p, size_t n) {
+    out->text = (char*)realloc(out->text, out->len + n + 1);
+    memcpy(out->text + out->len, p, n);
+    out->len += n;
+    out->text[out->len] = '\0';
+}
+
+static int sameOutput(const Output *a, const Output *b) {
+    return a->len == b->len && memcmp(a->text, b->text, a->len) == 0;
+}
+
+static void writeText(const char *path, const char *text, size_t len) {
+    FILE *f = fopen(path, "w");
+
+    if (f == NULL || fwrite(text, 1, len, f) != len || fclose(f) != 0) {
+        perror(path);
+        exit(1);
+    }
+}
+
+static void readText(const char *path, Output *out) {
+    char buf[65536];
+    FILE *f = fopen(path, "r");
+    size_t n;
+
+    out->len = 0;
+    append(out, "", 0);
+    if (f == NULL)
+        return;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        append(out, buf, n);
+    fclose(f);
+}
+
+// Run argv with path as its input, returns its exit status and what it printed in out
+static int runWith(const char *const *argv, const char *path, Output *out) {
+    char buf[65536];
+    int fds[2], in, status;
+    ssize_t n;
+    pid_t pid;
+
+    out->len = 0;
+    append(out, "", 0);
+    if ((in = open(path, O_RDONLY)) < 0 || pipe(fds) != 0) {
+        perror(path);
+        exit(1);
+    }
+    pid = fork();
+    if (pid == 0) {
+        dup2(in, 0);
+        dup2(fds[1], 1);
+        close(fds[0]);
+        close(fds[1]);
+        execv(argv[0], (char *const*)argv);
+        perror(argv[0]);
+        _exit(127);
+    }
+    close(in);
+    close(fds[1]);
+    while ((n = read(fds[0], buf, sizeof(buf))) > 0)
+        append(out, buf, n);
+    close(fds[0]);
+    if (pid < 0 || waitpid(pid, &status, 0) < 0) {
+        perror("waitpid");
+        exit(1);
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+}
+
+// The binary, then extra (NULL-terminated), then flags in argv
+static void makeArgs(const char **argv, const char *binary, const char *const *flags, const char *const *extra) {
+    int argc = 0;
+
+    argv[argc++] = binary;
+    while (extra != NULL && *extra != NULL)
+        argv[argc++] = *extra++;
+    for (int i = 0; i < 5 && flags[i] != NULL; i++)
+        argv[argc++] = flags[i];
+    argv[argc] = NULL;
+}
+
+// Run binary with flags on path, returns its exit status
+static int runFlags(const char *binary, const char *const *flags, const char *path, Output *out) {
+    const char *argv[8];
+
+    makeArgs(argv, binary, flags, NULL);
+    return runWith(argv, path, out);
+}
+
+// Send one request, returns its status or -1 if the server did not answer
+static int request(const char *sock, const char *text, size_t len, Output *reply) {
+    struct sockaddr_un addr;
+    char header[8], *body;
+    unsigned status, n;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, sock, sizeof(addr.sun_path) - 1);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+    putLE(header, (unsigned)len, 4);
+    writeAll(fd, header, 4);
+    writeAll(fd, text, len);
+    if (readFull(fd, header, 8) <= 0) {
+        close(fd);
+        return -1;
+    }
+    status = getLE((const unsigned char*)header, 4);
+    n = getLE((const unsigned char*)header + 4, 4);
+    body = (char*)malloc(n + 1);
+    if (n > 0 && readFull(fd, body, n) <= 0)
+        status = -1;
+    reply->len = 0;
+    append(reply, body, n);
+    free(body);
+    close(fd);
+    return (int)status;
+}
+
+// Start a server with the flags of c, send the program in path to it and
+// then a small one; the first reply must be what the binary prints
+static int serveCase(const char *binary, const Case *c, const char *path) {
+    char sock[64];
+    const char *argv[8], *extra[] = { "--serve", sock, NULL };
+    struct stat st;
+    Output text = { NULL, 0 }, direct = { NULL, 0 }, reply = { NULL, 0 };
+    int status, ok;
+    pid_t pid;
+
+    runFlags(binary, c->flags, path, &direct);
+    snprintf(sock, sizeof(sock), "%s.sock", path);
+    makeArgs(argv, binary, c->flags, extra);
+    pid = fork();
+    if (pid == 0) {
+        execv(binary, (char *const*)argv);
+        perror(binary);
+        _exit(127);
+    }
+    for (int i = 0; i < 200 && stat(sock, &st) != 0; i++)
+        usleep(10000);
+
+    readText(path, &text);
+    status = request(sock, text.text, text.len, &reply);
+    ok = status == SERVE_OK && sameOutput(&reply, &direct);
+    if (!ok)
+        printf("FAIL %s: status %d, %zu bytes instead of %zu\n", c->name, status, reply.len, direct.len);
+    else if ((status = request(sock, "x = 1\n", 6, &reply)) != SERVE_OK) {
+        printf("FAIL %s: no reply after it\n", c->name);
+        ok = 0;
+    }
+
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+    unlink(sock);
+    free(text.text);
+    free(direct.text);
+    free(reply.text);
+    return ok;
+}
+
+// Compile every file of c in one --batch run, then each on its own
+static int batchCase(const char *binary, const Case *c, const char *path) {
+    char names[4][64], outs[4][64];
+    const char *argv[16];
+    Output alone = { NULL, 0 }, written = { NULL, 0 };
+    int n = 0, argc, status, ok;
+
+    makeArgs(argv, binary, c->flags, NULL);
+    for (argc = 0; argv[argc] != NULL; argc++)
+        ;
+    for (; n < 4 && c->files[n] != NULL; n++) {
+        snprintf(names[n], sizeof(names[n]), "%s.%d", path, n);
+        snprintf(outs[n], sizeof(outs[n]), "%s.s", names[n]);
+        writeText(names[n], c->files[n], strlen(c->files[n]));
+        argv[argc++] = names[n];
+    }
+    argv[argc] = NULL;
+
+    status = runWith(argv, path, &alone);
+    ok = status == c->status;
+    if (!ok)
+        printf("FAIL %s: exit %d instead of %d\n", c->name, status, c->status);
+    for (int i = 0; i < n; i++) {
+        runFlags(binary, c->against, names[i], &alone);
+        readText(outs[i], &written);
+        if (ok && !sameOutput(&alone, &written)) {
+            printf("FAIL %s: %s differs, %zu bytes instead of %zu\n", c->name, outs[i], written.len, alone.len);
+            ok = 0;
+        }
+        unlink(names[i]);
+        unlink(outs[i]);
+    }
+    free(alone.text);
+    free(written.text);
+    return ok;
+}
+
+// Run the case in path with its flags, and check it the way its kind says
+static int runCase(const char *binary, const Case *c, const char *path) {
+    char bin[64];
+    const char *disasm[] = { "--disasm", NULL };
+    Output out = { NULL, 0 }, want = { NULL, 0 };
+    int status, wantStatus, ok = 1;
+
+    switch (c->kind) {
+        case SERVE:
+            return serveCase(binary, c, path);
+        case BATCH:
+            return batchCase(binary, c, path);
+        default:
+            break;
+    }
+
+    status = runFlags(binary, c->flags, path, &out);
+    switch (c->kind) {
+        case EXPECT:
+            ok = status == c->status && strcmp(out.text, c->expect) == 0;
+            if (!ok)
+                printf("FAIL %s: exit %d, printed %s", c->name, status, out.len ? out.text : "nothing\n");
+            break;
+        case SAME:
+        case ROUNDTRIP:
+            if (c->kind == ROUNDTRIP) {
+                snprintf(bin, sizeof(bin), "%s.bin", path);
+                writeText(bin, out.text, out.len);
+                status = runFlags(binary, disasm, bin, &out);
+                unlink(bin);
+            }
+            wantStatus = runFlags(binary, c->against, path, &want);
+            ok = status == wantStatus && sameOutput(&out, &want);
+            if (!ok)
+                printf("FAIL %s: exit %d, %zu bytes; exit %d, %zu bytes without\n",
+                       c->name, status, out.len, wantStatus, want.len);
+            break;
+    }
+    free(out.text);
+    free(want.text);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    const char *binary = "./miniproject";
+    char path[] = "/tmp/regress_XXXXXX";
+    int fd, failed = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-b") == 0)
+            binary = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [-b binary]\n", argv[0]);
+            return 1;
+        }
+    }
+    if ((fd = mkstemp(path)) < 0) {
+        perror(path);
+        return 1;
+    }
+    close(fd);
+    // a server that dies must not take this process with it
+    signal(SIGPIPE, SIG_IGN);
+
+    for (size_t k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        const Case *c = &cases[k];
+        FILE *f = fopen(path, "w");
+        int ok;
+
+        if (c->terms > 0)
+            writeDeep(f, c->shape, c->terms);
+        else if (c->workload != NULL)
+            writeWorkload(f, c->workload);
+        else if (c->program != NULL)
+            fputs(c->program, f);
+        fclose(f);
+        ok = runCase(binary, c, path);
+        if (ok)
+            printf("ok   %s\n", c->name);
+        failed += !ok;
+    }
+    unlink(path);
+    return failed > 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * Load generator for the compile server.
+ *
+ *   gcc -O2 -pthread -o miniproject miniproject.c
+ *   gcc -O2 -pthread -o serve_load bench/serve_load.c
+ *   ./miniproject --serve /tmp/miniproject.sock -j 4 &
+ *   ./serve_load [-S socket] [-c connections] [-n requests] [-l lines] [-k snippets]
+ *
+ * -k snippets of -l lines each come from writeWorkload() with seeds 1 ..
+ * k and are compiled here once, in process, for the expected replies.
+ * Each of -c connections then sends -n requests, one at a time, cycling
+ * through the snippets, and checks every reply byte for byte. Reports
+ * requests per second and the latency percentiles over all requests,
+ * from the first byte sent to the last byte received. The server serves
+ * -j connections at once, with more than that the rest wait their turn
+ * and it shows in the tail.
+ */
+#define MINIPROJECT_NO_MAIN
+#include "../miniproject.c"
+#define WORKLOAD_NO_MAIN
+#include "workload.c"
+
+typedef struct {
+    char *text;
+    size_t len;
+    unsigned status;
+    char *out;
+    size_t outLen;
+} Snippet;
+
+typedef struct {
+    const char *path;
+    const Snippet *snippets;
+    int count;
+    int requests;
+    int first;
+    double *latency;
+    int errors;
+} Client;
+
+static Snippet makeSnippet(unsigned seed, int lines) {
+    Snippet sn = { 0 };
+    Workload w = { seed, lines, 3, 8, "++--**/&|^", 0, 0 };
+    FILE *f = open_memstream(&sn.text, &sn.len);
+    Compiler *cc = newCompiler(NULL);
+
+    writeWorkload(f, &w);
+    fclose(f);
+    cc->srcBegin = cc->srcCur = sn.text;
+    cc->srcEnd = sn.text + sn.len;
+    cc->outFd = -1;
+    cc->quiet = 1;
+    compile(cc);
+    finish(cc);
+    sn.status = cc->failed ? SERVE_EXIT1 : SERVE_OK;
+    sn.out = (char*)malloc(cc->outLen + 1);
+    memcpy(sn.out, cc->outBuf, cc->outLen);
+    sn.outLen = cc->outLen;
+    freeCompiler(cc);
+    return sn;
+}
+
+static int connectTo(const char *path) {
+    struct sockaddr_un addr;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        perror(path);
+        exit(1);
+    }
+    return fd;
+}
+
+static void *runClient(void *arg) {
+    Client *c = (Client*)arg;
+    int fd = connectTo(c->path);
+    char *buf = NULL;
+    size_t cap = 0;
+
+    for (int i = 0; i < c->requests; i++) {
+        const Snippet *sn = &c->snippets[(c->first + i) % c->count];
+        char header[8];
+        unsigned status, len;
+        double t0 = now();
+
+        putLE(header, (unsigned)sn->len, 4);
+        writeAll(fd, header, 4);
+        writeAll(fd, sn->text, sn->len);
+        if (readFull(fd, header, 8) <= 0) {
+            fprintf(stderr, "the server closed the connection\n");
+            exit(1);
+        }
+        status = getLE((const unsigned char*)header, 4);
+        len = getLE((const unsigned char*)header + 4, 4);
+        if (len > cap)
+            buf = (char*)realloc(buf, cap = len);
+        if (len > 0 && readFull(fd, buf, len) <= 0) {
+            fprintf(stderr, "the server closed the connection\n");
+            exit(1);
+        }
+        c->latency[i] = now() - t0;
+        if (status != sn->status || len != sn->outLen || memcmp(buf, sn->out, len) != 0)
+            c->errors++;
+    }
+    free(buf);
+    close(fd);
+    return NULL;
+}
+
+static int cmpDouble(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return x < y ? -1 : x > y;
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = "/tmp/miniproject.sock";
+    int conns = 4, requests = 10000, lines = 8, count = 64, errors = 0;
+    Snippet *snippets;
+    Client *clients;
+    pthread_t *threads;
+    double *latency, t0, t, sum = 0;
+    long total;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = i + 1 < argc ? argv[i + 1] : NULL;
+        if (arg == NULL || argv[i][0] != '-' || strlen(argv[i]) != 2) {
+            fprintf(stderr, "usage: %s [-S socket] [-c connections] [-n requests] [-l lines] [-k snippets]\n",
+                    argv[0]);
+            return 1;
+        }
+        switch (argv[i][1]) {
+            case 'S': path = arg; break;
+            case 'c': conns = atoi(arg); break;
+            case 'n': requests = atoi(arg); break;
+            case 'l': lines = atoi(arg); break;
+            case 'k': count = atoi(arg); break;
+            default:
+                fprintf(stderr, "unknown option %s\n", argv[i]);
+                return 1;
+        }
+        i++;
+    }
+    if (conns < 1 || requests < 1 || lines < 1 || count < 1) {
+        fprintf(stderr, "-c, -n, -l and -k must be positive\n");
+        return 1;
+    }
+
+    snippets = (Snippet*)malloc(count * sizeof(Snippet));
+    for (int k = 0; k < count; k++)
+        snippets[k] = makeSnippet(k + 1, lines);
+    total = (long)conns * requests;
+    latency = (double*)malloc(total * sizeof(double));
+    clients = (Client*)calloc(conns, sizeof(Client));
+    threads = (pthread_t*)malloc(conns * sizeof(pthread_t));
+
+    t0 = now();
+    for (int i = 0; i < conns; i++) {
+        clients[i] = (Client){ path, snippets, count, requests, i, latency + (long)i * requests, 0 };
+        if (pthread_create(&threads[i], NULL, runClient, &clients[i]) != 0) {
+            perror("pthread_create");
+            return 1;
+        }
+    }
+    for (int i = 0; i < conns; i++) {
+        pthread_join(threads[i], NULL);
+        errors += clients[i].errors;
+    }
+    t = now() - t0;
+
+    qsort(latency, total, sizeof(double), cmpDouble);
+    for (long i = 0; i < total; i++)
+        sum += latency[i];
+    printf("%ld requests on %d connections in %.3f s, %.0f requests/s\n", total, conns, t, total / t);
+    printf("latency us: mean %.1f  p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n",
+           sum / total * 1e6, latency[total / 2] * 1e6, latency[total * 9 / 10] * 1e6,
+           latency[total * 99 / 100] * 1e6, latency[total - 1] * 1e6);
+    if (errors > 0) {
+        fprintf(stderr, "%d replies differ from the compiler in process\n", errors);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,480 @@
+/*
+ * Superoptimizer for small expression trees, writes superopt_table.h.
+ *
+ *   gcc -O2 -pthread -o superopt bench/superopt.c
+ *   ./superopt > superopt_table.h
+ *
+ * Programs are enumerated breadth first, shortest first, over the
+ * instructions --superopt may emit: MOV r, leaf (a load or a constant
+ * leaf), MOV r, imm for every superImm[], MOV r, r and ADD SUB MUL AND
+ * OR XOR r, r, on SUPER_REGS registers, up to SUPER_LEN instructions.
+ * The state after a program is what its registers hold, as values on
+ * TESTS test inputs; states seen before are not expanded again, so the
+ * first program that leaves a value in r0 is a shortest one for it.
+ * Then every canonical tree of up to SUPER_LEAVES leaves (see
+ * superTable[]) is evaluated on the same inputs, and gets an entry when
+ * a program is shorter than the one instruction per node evaluateTree()
+ * emits. Each entry is checked again on CHECKS fresh random inputs,
+ * a program that only agreed with the tree by chance is dropped with a
+ * warning. Last, an entry is left out when evaluateTree() gets the
+ * tree just as short from the entries of its subtrees. Division is left
+ * out, evaluateTree() has to judge it. The same build always writes the
+ * same table.
+ *
+ * The programs are the shortest on these SUPER_REGS registers and
+ * superImm[] constants; that they compute their tree is tested, not
+ * proven, on TESTS + CHECKS inputs that include 0, 1, -1, INT_MIN and
+ * INT_MAX.
+ */
+#define MINIPROJECT_NO_MAIN
+#define MINIPROJECT_NO_SUPERTABLE
+#include "../miniproject.c"
+
+#define TESTS 16
+#define CHECKS 10000
+
+typedef struct {
+    unsigned v[TESTS];
+} Value;
+
+// What r0 .. r<SUPER_REGS - 1> hold, value numbers (0 is not yet written)
+typedef struct {
+    int r[SUPER_REGS];
+    int parent;
+    unsigned char code;
+} State;
+
+// value number 0 stands for a register not written yet
+static Value *values;
+static int valueCount = 1, valueCap;
+static int *valueHash, valueHashCap;
+// per value number, the first state that has it in r0
+static int *best;
+
+static State *states;
+static int stateCount, stateCap;
+static int *stateHash, stateHashCap;
+
+static unsigned inputs[SUPER_INPUTS][TESTS];
+static unsigned seed = 12345;
+
+static unsigned nextRand(void) {
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 16) | (seed << 16);
+}
+
+static unsigned hashWords(const unsigned *w, int n) {
+    unsigned h = 2166136261u;
+    for (int i = 0; i < n; i++)
+        h = (h ^ w[i]) * 16777619u;
+    return h;
+}
+
+static void growValues(void) {
+    int *old = valueHash, oldCap = valueHashCap;
+
+    valueHashCap = valueHashCap ? valueHashCap * 2 : 1 << 16;
+    valueHash = (int*)calloc(valueHashCap, sizeof(int));
+    for (int i = 0; i < oldCap; i++) {
+        if (old[i]) {
+            unsigned h = hashWords(values[old[i]].v, TESTS) & (valueHashCap - 1);
+            while (valueHash[h])
+                h = (h + 1) & (valueHashCap - 1);
+            valueHash[h] = old[i];
+        }
+    }
+    free(old);
+}
+
+// The number of a value, made if it is new
+static int internValue(const Value *v) {
+    unsigned h;
+
+    if (valueCount * 2 >= valueHashCap)
+        growValues();
+    h = hashWords(v->v, TESTS) & (valueHashCap - 1);
+    while (valueHash[h]) {
+        if (memcmp(&values[valueHash[h]], v, sizeof(Value)) == 0)
+            return valueHash[h];
+        h = (h + 1) & (valueHashCap - 1);
+    }
+    if (valueCount >= valueCap) {
+        valueCap = valueCap ? valueCap * 2 : 1 << 16;
+        values = (Value*)realloc(values, valueCap * sizeof(Value));
+        best = (int*)realloc(best, valueCap * sizeof(int));
+    }
+    values[valueCount] = *v;
+    best[valueCount] = -1;
+    valueHash[h] = valueCount;
+    return valueCount++;
+}
+
+// The value number of a tree or program, or -1 when nothing has it
+static int findValue(const Value *v) {
+    unsigned h = hashWords(v->v, TESTS) & (valueHashCap - 1);
+    while (valueHash[h]) {
+        if (memcmp(&values[valueHash[h]], v, sizeof(Value)) == 0)
+            return valueHash[h];
+        h = (h + 1) & (valueHashCap - 1);
+    }
+    return -1;
+}
+
+static void growStates(void) {
+    int *old = stateHash, oldCap = stateHashCap;
+
+    stateHashCap = stateHashCap ? stateHashCap * 2 : 1 << 16;
+    stateHash = (int*)calloc(stateHashCap, sizeof(int));
+    for (int i = 0; i < oldCap; i++) {
+        if (old[i]) {
+            unsigned h = hashWords((unsigned*)states[old[i] - 1].r, SUPER_REGS) & (stateHashCap - 1);
+            while (stateHash[h])
+                h = (h + 1) & (stateHashCap - 1);
+            stateHash[h] = old[i];
+        }
+    }
+    free(old);
+}
+
+// Add the state r after parent and code, unless some program got there already
+static void addState(const int *r, int parent, unsigned char code) {
+    unsigned h;
+
+    if (stateCount * 2 >= stateHashCap)
+        growStates();
+    h = hashWords((const unsigned*)r, SUPER_REGS) & (stateHashCap - 1);
+    while (stateHash[h]) {
+        if (memcmp(states[stateHash[h] - 1].r, r, sizeof(int) * SUPER_REGS) == 0)
+            return;
+        h = (h + 1) & (stateHashCap - 1);
+    }
+    if (stateCount == stateCap) {
+        stateCap = stateCap ? stateCap * 2 : 1 << 16;
+        states = (State*)realloc(states, stateCap * sizeof(State));
+    }
+    memcpy(states[stateCount].r, r, sizeof(int) * SUPER_REGS);
+    states[stateCount].parent = parent;
+    states[stateCount].code = code;
+    stateHash[h] = ++stateCount;
+    if (r[0] > 0 && best[r[0]] < 0)
+        best[r[0]] = stateCount - 1;
+}
+
+// The state after one more instruction, 0 if it reads a register not written yet
+static int step(const State *s, unsigned char code, int *r) {
+    int kind = code & 15, d = code >> 4 & 3, src = code >> 6;
+    Value v;
+
+    memcpy(r, s->r, sizeof(int) * SUPER_REGS);
+    if (kind == SUPER_LOAD) {
+        memcpy(v.v, inputs[src], sizeof(v.v));
+    }
+    else if (kind == SUPER_IMM) {
+        for (int t = 0; t < TESTS; t++)
+            v.v[t] = superImm[src];
+    }
+    else if (s->r[src] == 0) {
+        return 0;
+    }
+    else if (kind == SUPER_MOVR) {
+        v = values[s->r[src]];
+    }
+    else if (s->r[d] == 0) {
+        return 0;
+    }
+    else {
+        for (int t = 0; t < TESTS; t++)
+            v.v[t] = calc("?+-*/&|^"[kind], values[s->r[d]].v[t], values[s->r[src]].v[t]);
+    }
+    r[d] = internValue(&v);
+    return 1;
+}
+
+static void search(void) {
+    int r[SUPER_REGS] = { 0 }, first = 0;
+
+    addState(r, -1, 0);
+    for (int len = 1; len <= SUPER_LEN; len++) {
+        int last = stateCount;
+        for (int i = first; i < last; i++) {
+            for (int kind = OP_ADD; kind <= SUPER_IMM; kind++) {
+                if (kind == OP_DIV || kind == OP_EXIT)
+                    continue;
+                for (int d = 0; d < SUPER_REGS; d++) {
+                    for (int src = 0; src < 3; src++) {
+                        unsigned char code = (unsigned char)(kind | d << 4 | src << 6);
+                        if (step(&states[i], code, r))
+                            addState(r, i, code);
+                    }
+                }
+            }
+        }
+        fprintf(stderr, "%d instructions: %d states, %d values\n", len, stateCount - last, valueCount);
+        first = last;
+    }
+}
+
+/* Trees are strings of symbols in prefix order, as in superTable[] keys */
+typedef struct {
+    unsigned char sym[2 * SUPER_LEAVES - 1];
+    int len;
+} Tree;
+
+// Evaluate the subtree at t->sym[*pos] with its leaves set to in[]
+static unsigned evalTree(const Tree *t, int *pos, const unsigned *in) {
+    int s = t->sym[(*pos)++];
+    unsigned a, b;
+
+    if (s == SUPER_ZERO)
+        return 0;
+    if (s >= SUPER_LEAF)
+        return in[s - SUPER_LEAF];
+    a = evalTree(t, pos, in);
+    b = evalTree(t, pos, in);
+    return (unsigned)calc("?+-*/&|^"[s], (int)a, (int)b);
+}
+
+static unsigned runCode(const unsigned char *code, int len, const unsigned *in) {
+    unsigned r[SUPER_REGS] = { 0 };
+
+    for (int i = 0; i < len; i++) {
+        int kind = code[i] & 15, d = code[i] >> 4 & 3, src = code[i] >> 6;
+        if (kind == SUPER_LOAD)
+            r[d] = in[src];
+        else if (kind == SUPER_IMM)
+            r[d] = (unsigned)superImm[src];
+        else if (kind == SUPER_MOVR)
+            r[d] = r[src];
+        else
+            r[d] = (unsigned)calc("?+-*/&|^"[kind], (int)r[d], (int)r[src]);
+    }
+    return r[0];
+}
+
+static void printTree(FILE *f, const Tree *t, int *pos) {
+    int s = t->sym[(*pos)++];
+
+    if (s == SUPER_ZERO) {
+        fputc('0', f);
+    }
+    else if (s >= SUPER_LEAF) {
+        fputc("abc"[s - SUPER_LEAF], f);
+    }
+    else {
+        fputc('(', f);
+        printTree(f, t, pos);
+        fprintf(f, " %c ", "?+-*/&|^"[s]);
+        printTree(f, t, pos);
+        fputc(')', f);
+    }
+}
+
+static void printCode(FILE *f, const unsigned char *code, int len) {
+    for (int i = 0; i < len; i++) {
+        int kind = code[i] & 15, d = code[i] >> 4 & 3, src = code[i] >> 6;
+        static const char *names[] = { "MOV", "ADD", "SUB", "MUL", "DIV", "AND", "OR", "XOR" };
+        if (kind == SUPER_LOAD)
+            fprintf(f, "%sMOV r%d %c", i ? "; " : "", d, "abc"[src]);
+        else if (kind == SUPER_IMM)
+            fprintf(f, "%sMOV r%d %d", i ? "; " : "", d, superImm[src]);
+        else
+            fprintf(f, "%s%s r%d r%d", i ? "; " : "", kind == SUPER_MOVR ? "MOV" : names[kind], d, src);
+    }
+}
+
+static int hasLeaf(const Tree *t, int i) {
+    for (int k = 0; k < t->len; k++)
+        if (t->sym[k] == SUPER_LEAF + i)
+            return 1;
+    return 0;
+}
+
+static SuperEntry *entries;
+static Tree *entryTrees;
+static int entryCount, entryCap, treeCount, dropped;
+
+static void addTree(const Tree *t) {
+    Value v;
+    int id, s, len = 0, pos;
+    unsigned char code[SUPER_LEN];
+    unsigned in[SUPER_INPUTS];
+    SuperEntry *e;
+
+    treeCount++;
+    for (int k = 0; k < TESTS; k++) {
+        for (int i = 0; i < SUPER_INPUTS; i++)
+            in[i] = inputs[i][k];
+        pos = 0;
+        v.v[k] = evalTree(t, &pos, in);
+    }
+    id = findValue(&v);
+    if (id < 0 || best[id] < 0)
+        return;
+    for (s = best[id]; states[s].parent >= 0; s = states[s].parent)
+        len++;
+    // evaluateTree() takes one instruction per node
+    if (len >= t->len)
+        return;
+    for (s = best[id], pos = len; states[s].parent >= 0; s = states[s].parent) {
+        code[--pos] = states[s].code;
+        // superEvaluate() only knows the leaves the tree has
+        if ((code[pos] & 15) == SUPER_LOAD && !hasLeaf(t, code[pos] >> 6))
+            return;
+    }
+
+    for (int k = 0; k < CHECKS; k++) {
+        for (int i = 0; i < SUPER_INPUTS; i++)
+            in[i] = nextRand();
+        pos = 0;
+        if (runCode(code, len, in) != evalTree(t, &pos, in)) {
+            fprintf(stderr, "dropped ");
+            pos = 0;
+            printTree(stderr, t, &pos);
+            fprintf(stderr, ", it differs from ");
+            printCode(stderr, code, len);
+            fprintf(stderr, "\n");
+            dropped++;
+            return;
+        }
+    }
+
+    if (entryCount == entryCap) {
+        entryCap = entryCap ? entryCap * 2 : 1024;
+        entries = (SuperEntry*)realloc(entries, entryCap * sizeof(SuperEntry));
+        entryTrees = (Tree*)realloc(entryTrees, entryCap * sizeof(Tree));
+    }
+    e = &entries[entryCount];
+    memset(e, 0, sizeof(*e));
+    for (int i = 0; i < t->len; i++)
+        e->key = e->key << 4 | t->sym[i];
+    e->len = (unsigned char)len;
+    memcpy(e->code, code, len);
+    entryTrees[entryCount++] = *t;
+}
+
+// Every tree that goes on from t with open operands still to fill, ops
+// operators so far and inputs distinct leaves named in order
+static void makeTrees(Tree *t, int open, int ops, int inputs) {
+    if (open == 0) {
+        if (ops > 0)
+            addTree(t);
+        return;
+    }
+    if (ops + 1 < SUPER_LEAVES) {
+        for (int op = OP_ADD; op <= OP_XOR; op++) {
+            if (op == OP_DIV)
+                continue;
+            t->sym[t->len++] = (unsigned char)op;
+            makeTrees(t, open + 1, ops + 1, inputs);
+            t->len--;
+        }
+    }
+    for (int s = SUPER_ZERO; s <= SUPER_LEAF + inputs && s < SUPER_LEAF + SUPER_INPUTS; s++) {
+        t->sym[t->len++] = (unsigned char)s;
+        makeTrees(t, open - 1, ops, s == SUPER_LEAF + inputs ? inputs + 1 : inputs);
+        t->len--;
+    }
+}
+
+static int cmpEntry(const void *a, const void *b) {
+    unsigned x = entries[*(const int*)a].key, y = entries[*(const int*)b].key;
+    return x < y ? -1 : x > y;
+}
+
+static int *order;
+
+// Copy the subtree at t->sym[*pos] to sub, naming its leaves again from a
+static void copySubtree(const Tree *t, int *pos, Tree *sub, int *names) {
+    int s = t->sym[(*pos)++];
+
+    if (s >= SUPER_LEAF) {
+        if (names[s - SUPER_LEAF] < 0)
+            names[s - SUPER_LEAF] = names[SUPER_INPUTS]++;
+        s = SUPER_LEAF + names[s - SUPER_LEAF];
+    }
+    sub->sym[sub->len++] = (unsigned char)s;
+    if (s < SUPER_ZERO) {
+        copySubtree(t, pos, sub, names);
+        copySubtree(t, pos, sub, names);
+    }
+}
+
+static const SuperEntry *findEntry(const Tree *t) {
+    int lo = 0, hi = entryCount;
+    unsigned key = 0;
+
+    for (int i = 0; i < t->len; i++)
+        key = key << 4 | t->sym[i];
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (entries[order[mid]].key < key)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo < entryCount && entries[order[lo]].key == key ? &entries[order[lo]] : NULL;
+}
+
+// The instructions evaluateTree() spends on t with every entry in the
+// table, but without the one of t itself unless own is set
+static int treeCost(const Tree *t, int own) {
+    Tree left = { { 0 }, 0 }, right = { { 0 }, 0 };
+    int pos = 1, names[SUPER_INPUTS + 1], cost;
+    const SuperEntry *e;
+
+    if (t->len == 1)
+        return 1;
+    memset(names, -1, sizeof(int) * SUPER_INPUTS);
+    names[SUPER_INPUTS] = 0;
+    copySubtree(t, &pos, &left, names);
+    memset(names, -1, sizeof(int) * SUPER_INPUTS);
+    names[SUPER_INPUTS] = 0;
+    copySubtree(t, &pos, &right, names);
+    cost = treeCost(&left, 1) + treeCost(&right, 1) + 1;
+    e = own ? findEntry(t) : NULL;
+    return e != NULL && e->len < cost ? e->len : cost;
+}
+
+int main(void) {
+    static const unsigned edges[] = { 0, 1, 0xffffffffu, 0x80000000u, 0x7fffffffu, 2 };
+    Tree t = { { 0 }, 0 };
+    int *keep, kept = 0;
+
+    for (int i = 0; i < SUPER_INPUTS; i++)
+        for (int k = 0; k < TESTS; k++)
+            inputs[i][k] = k < 6 ? edges[(k + 2 * i) % 6] : nextRand();
+    search();
+    makeTrees(&t, 1, 0, 0);
+
+    order = (int*)malloc(entryCount * sizeof(int));
+    keep = (int*)malloc(entryCount * sizeof(int));
+    for (int i = 0; i < entryCount; i++)
+        order[i] = i;
+    qsort(order, entryCount, sizeof(int), cmpEntry);
+    // an entry no shorter than what the entries of its subtrees make of it is left out
+    for (int i = 0; i < entryCount; i++)
+        if (entries[order[i]].len < treeCost(&entryTrees[order[i]], 0))
+            keep[kept++] = order[i];
+    fprintf(stderr, "%d trees, %d entries, %d dropped, %d kept\n", treeCount, entryCount, dropped, kept);
+
+    printf("/* Written by bench/superopt.c, do not edit.\n"
+           "   %d of the %d trees of up to %d leaves have code shorter than what\n"
+           "   evaluateTree() makes of their subtrees. Sorted by key for\n"
+           "   superEvaluate(), every entry is followed by its tree and code. */\n",
+           kept, treeCount, SUPER_LEAVES);
+    printf("static const SuperEntry superTable[] = {\n");
+    for (int i = 0; i < kept; i++) {
+        const SuperEntry *e = &entries[keep[i]];
+        int pos = 0;
+        printf("    { 0x%05x, %d, {", e->key, e->len);
+        for (int k = 0; k < e->len; k++)
+            printf(" 0x%02x%s", e->code[k], k + 1 < e->len ? "," : "");
+        printf(" } },  // ");
+        printTree(stdout, &entryTrees[keep[i]], &pos);
+        printf(": ");
+        printCode(stdout, e->code, e->len);
+        printf("\n");
+    }
+    printf("};\n");
+    return 0;
+}
@@ -0,0 +1,291 @@
+/*
+ * Reproducible synthetic inputs for the benchmarks.
+ *
+ *   gcc -O2 -o workload bench/workload.c
+ *   ./workload [-s seed] [-n statements] [-d depth] [-v variables]
+ *              [-m ops] [-p parens] [-c chain] > input.txt
+ *
+ * Every variable is assigned first, and '/' only ever divides by a
+ * variable or a non-zero constant, so the program compiles to the end.
+ *   -d  maximum expression depth, subtrees stop early now and then
+ *   -m  operator mix: a character per operator, repeat one to weigh it
+ *       more; the default weighs + - and * twice as much as / & | and ^
+ *   -p  now and then wrap an operand in up to this many extra parentheses
+ *   -c  one statement in four becomes a chain of this many ++ / -- terms
+ *       or += / -= assignments
+ * The same options and seed always give the same text.
+ *
+ * The benchmarks include this file with WORKLOAD_NO_MAIN for
+ * writeWorkload(), the deep statements of writeDeep(), the inputs made
+ * in memory by makeInput() and now().
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    unsigned seed;
+    long statements;
+    int depth;
+    int vars;
+    const char *ops;
+    int parens;
+    int chain;
+} Workload;
+
+static unsigned wlState;
+
+static unsigned wlRand(void) {
+    wlState = wlState * 1103515245u + 12345u;
+    return wlState >> 8;
+}
+
+static int wlPrec(int op) {
+    switch (op) {
+        case '|': return 1;
+        case '^': return 2;
+        case '&': return 3;
+        case '+':
+        case '-': return 4;
+        default: return 5;
+    }
+}
+
+static void wlVar(FILE *f, int v) {
+    if (v < 3)
+        fputc("xyz"[v], f);
+    else
+        fprintf(f, "v%d", v);
+}
+
+// A constant, a variable or ++/-- on one; divisors are never 0 and
+// after a unary minus there is no ++/-- to keep "---" out of the text
+enum { LEAF_ANY, LEAF_DIVISOR, LEAF_NEGATED };
+
+static void wlLeaf(FILE *f, const Workload *w, int kind) {
+    unsigned r = wlRand();
+
+    switch (r % 8) {
+        case 0:
+        case 1:
+        case 2:
+            fprintf(f, "%u", kind == LEAF_DIVISOR ? 1 + (r >> 3) % 9 : (r >> 3) % 1000);
+            break;
+        case 3:
+            if (kind == LEAF_ANY) {
+                fputs((r >> 3) & 1 ? "++" : "--", f);
+                wlVar(f, (r >> 4) % w->vars);
+                break;
+            }
+            /* fall through */
+        default:
+            wlVar(f, (r >> 3) % w->vars);
+            break;
+    }
+}
+
+// Print an expression that binds at least as tightly as minPrec
+static void wlExpr(FILE *f, const Workload *w, int depth, int minPrec) {
+    unsigned r = wlRand();
+    int op, parens = 0;
+
+    if (w->parens > 0 && r % 20 == 0)
+        parens = 1 + (r >> 5) % w->parens;
+    for (int i = 0; i < parens; i++)
+        fputc('(', f);
+    if (depth <= 0 || (r >> 10) % 4 == 0) {
+        if ((r >> 12) % 16 == 0) {
+            fputc('-', f);
+            wlLeaf(f, w, LEAF_NEGATED);
+        }
+        else {
+            wlLeaf(f, w, LEAF_ANY);
+        }
+    }
+    else {
+        op = w->ops[(r >> 14) % strlen(w->ops)];
+        if (wlPrec(op) < minPrec && parens == 0)
+            fputc('(', f);
+        wlExpr(f, w, depth - 1, wlPrec(op));
+        fprintf(f, " %c ", op);
+        if (op == '/')
+            wlLeaf(f, w, LEAF_DIVISOR);
+        else
+            wlExpr(f, w, depth - 1, wlPrec(op) + 1);
+        if (wlPrec(op) < minPrec && parens == 0)
+            fputc(')', f);
+    }
+    for (int i = 0; i < parens; i++)
+        fputc(')', f);
+}
+
+static void wlChain(FILE *f, const Workload *w) {
+    if (wlRand() % 2) {
+        wlVar(f, wlRand() % w->vars);
+        fputs(" = ", f);
+        for (int i = 0; i < w->chain; i++) {
+            unsigned r = wlRand();
+            if (i > 0)
+                fputs(r & 1 ? " + " : " - ", f);
+            fputs(r & 2 ? "++" : "--", f);
+            wlVar(f, (r >> 2) % w->vars);
+        }
+    }
+    else {
+        for (int i = 0; i < w->chain; i++) {
+            wlVar(f, wlRand() % w->vars);
+            fputs(wlRand() % 2 ? " += " : " -= ", f);
+        }
+        wlExpr(f, w, w->depth, 0);
+    }
+    fputc('\n', f);
+}
+
+void writeWorkload(FILE *f, const Workload *w) {
+    long n = 0;
+
+    wlState = w->seed;
+    for (int v = 0; v < w->vars && n < w->statements; v++, n++) {
+        wlVar(f, v);
+        fprintf(f, " = %u\n", wlRand() % 1000);
+    }
+    for (; n < w->statements; n++) {
+        unsigned r = wlRand();
+        if (w->chain > 0 && r % 4 == 0) {
+            wlChain(f, w);
+            continue;
+        }
+        switch ((r >> 2) % 8) {
+            case 0:
+                break;
+            case 1:
+                wlVar(f, (r >> 5) % w->vars);
+                fputs((r >> 4) & 1 ? " += " : " -= ", f);
+                break;
+            default:
+                wlVar(f, (r >> 5) % w->vars);
+                fputs(" = ", f);
+                break;
+        }
+        wlExpr(f, w, w->depth, 0);
+        fputc('\n', f);
+    }
+}
+
+// Kinds of writeDeep(): y = x + x + ... + x, y = x - (x - (... - x)),
+// y = - - ... - x and y = y = ... = x, after x = 1
+enum { DEEP_LEFT, DEEP_RIGHT, DEEP_NEG, DEEP_ASSIGN };
+
+// One statement nested terms deep
+void writeDeep(FILE *f, int shape, int terms) {
+    fputs("x = 1\ny = ", f);
+    for (int i = 1; i < terms; i++) {
+        switch (shape) {
+            case DEEP_LEFT: fputs("x + ", f); break;
+            case DEEP_RIGHT: fputs("x - (", f); break;
+            case DEEP_NEG: fputs("- ", f); break;
+            default: fputs("y = ", f); break;
+        }
+    }
+    fputc('x', f);
+    for (int i = 1; shape == DEEP_RIGHT && i < terms; i++)
+        fputc(')', f);
+    fputc('\n', f);
+}
+
+// A text made in memory, for the benchmarks that do not read a file
+typedef struct {
+    const char *name;
+    char *text;
+    size_t len;
+} Input;
+
+// Kinds of makeInput(): the "mixed" workload of 200000 statements, the
+// left- and right-leaning deep statements of a million terms, and lines
+// of long runs for the lexer: names of 24 to 64 characters, numbers of
+// 16 to 48 digits, and blanks of 8 to 64 around short names and numbers
+enum { INPUT_MIXED, INPUT_LEFT, INPUT_RIGHT, INPUT_NAMES, INPUT_NUMBERS, INPUT_BLANKS };
+
+static int wlPick(int lo, int hi) {
+    return lo + (int)(wlRand() % (unsigned)(hi - lo + 1));
+}
+
+static void wlRun(FILE *f, const char *chars, int len) {
+    int n = (int)strlen(chars);
+    for (int i = 0; i < len; i++)
+        fputc(chars[wlPick(0, n - 1)], f);
+}
+
+Input makeInput(const char *name, int kind) {
+    Input in = { name, NULL, 0 };
+    FILE *f = open_memstream(&in.text, &in.len);
+
+    if (kind == INPUT_MIXED) {
+        Workload w = { 1, 200000, 4, 64, "++--**/&|^", 0, 0 };
+        writeWorkload(f, &w);
+    }
+    else if (kind == INPUT_LEFT || kind == INPUT_RIGHT) {
+        writeDeep(f, kind == INPUT_LEFT ? DEEP_LEFT : DEEP_RIGHT, 1000000);
+    }
+    wlState = 1;
+    for (int line = 0; kind >= INPUT_NAMES && line < 100000; line++) {
+        for (int i = 0; i < 4; i++) {
+            if (kind == INPUT_BLANKS)
+                wlRun(f, " \t", wlPick(8, 64));
+            if (kind == INPUT_NAMES || (kind == INPUT_BLANKS && i % 2 == 0)) {
+                wlRun(f, "abcdefghijklmnopqrstuvwxyz_", 1);
+                wlRun(f, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789",
+                      kind == INPUT_NAMES ? wlPick(23, 63) : wlPick(0, 4));
+            }
+            else {
+                wlRun(f, "123456789", 1);
+                wlRun(f, "0123456789", kind == INPUT_NUMBERS ? wlPick(15, 47) : wlPick(0, 3));
+            }
+            fputs(i == 0 ? " = " : i < 3 ? " + " : "\n", f);
+        }
+    }
+    fclose(f);
+    return in;
+}
+
+// Seconds on the monotonic clock
+double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#ifndef WORKLOAD_NO_MAIN
+int main(int argc, char *argv[]) {
+    Workload w = { 1, 100000, 4, 64, "++--**/&|^", 0, 0 };
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = i + 1 < argc ? argv[i + 1] : NULL;
+        if (arg == NULL || argv[i][0] != '-' || strlen(argv[i]) != 2) {
+            fprintf(stderr, "usage: %s [-s seed] [-n statements] [-d depth] [-v variables]"
+                    " [-m ops] [-p parens] [-c chain]\n", argv[0]);
+            return 1;
+        }
+        switch (argv[i][1]) {
+            case 's': w.seed = strtoul(arg, NULL, 10); break;
+            case 'n': w.statements = atol(arg); break;
+            case 'd': w.depth = atoi(arg); break;
+            case 'v': w.vars = atoi(arg); break;
+            case 'm': w.ops = arg; break;
+            case 'p': w.parens = atoi(arg); break;
+            case 'c': w.chain = atoi(arg); break;
+            default:
+                fprintf(stderr, "unknown option %s\n", argv[i]);
+                return 1;
+        }
+        i++;
+    }
+    if (w.vars < 3 || w.ops[strspn(w.ops, "+-*/&|^")] != '\0' || w.ops[0] == '\0') {
+        fprintf(stderr, "need at least 3 variables and an operator mix made of +-*/&|^\n");
+        return 1;
+    }
+    writeWorkload(stdout, &w);
+    return 0;
+}
+#endif
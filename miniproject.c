@@ -2,11 +2,29 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <time.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 
-// for lex
-#define MAXLEN 256
+// Everything one compilation reads and writes lives in a Compiler
+// (see "for compiler context"), so several can run side by side
+typedef struct Compiler Compiler;
+
 
+// for lex
 // Token types
 typedef enum {
     UNKNOWN, END, ENDFILE,
@@ -18,33 +36,66 @@ typedef enum {
     INCDEC, ADDSUB_ASSIGN
 } TokenSet;
 
-TokenSet getToken(void);
-TokenSet curToken = UNKNOWN;
-char lexeme[MAXLEN];
+// A lexeme is a slice of the input buffer, it is not NUL-terminated
+typedef struct {
+    const char *ptr;
+    int len;
+} Lexeme;
+
+// Load the source file (stdin if path is NULL) into the input buffer
+void openInput(Compiler *cc, const char *path);
+// Same as openInput(), but returns -1 instead of exiting when the file cannot be read
+int readInput(Compiler *cc, const char *path);
+// Unmap or free the input buffer
+void closeInput(Compiler *cc);
+
+TokenSet getToken(Compiler *cc);
+
+// Classes of characters, charClass[c] is the mask of those c is in;
+// CC_ALPHA takes '_' too, CC_IDENT is what a name goes on with
+#define CC_BLANK 1
+#define CC_DIGIT 2
+#define CC_ALPHA 4
+#define CC_IDENT (CC_DIGIT | CC_ALPHA)
+extern const unsigned char charClass[256];
+// How runs of blanks, digits and names are scanned: a byte at a time, or
+// 16 (SSE2) or 32 (AVX2) at once. newCompiler() picks the widest the CPU
+// has the first time it runs, set it afterwards to force another.
+enum { SCAN_SCALAR, SCAN_SSE2, SCAN_AVX2 };
+extern int lexScan;
+// The end of the run of characters in class cls that starts at p, at most end
+const char *scanRun(const char *p, const char *end, int cls);
+
+// The parser reads tokens through a ring of up to LOOKAHEAD (a power of
+// 2) tokens lexed ahead of it; characters the lexer does not know (UNKNOWN) never get in
+#define LOOKAHEAD 4
+typedef struct {
+    TokenSet tok;
+    Lexeme lexeme;
+} Token;
 
+// Token k places after the current one, k < LOOKAHEAD
+TokenSet peekToken(Compiler *cc, int k);
 // Test if a token matches the current token
-int match(TokenSet token);
+int match(Compiler *cc, TokenSet token);
 // Get the next token
-void advance(void);
+void advance(Compiler *cc);
 // Get the lexeme of the current token
-char *getLexeme(void);
-void settoken(void) {
-    curToken = UNKNOWN;
-}
+Lexeme getLexeme(Compiler *cc);
 
 
 // for parser
+// Initial capacity of the symbol table, it grows on demand
 #define TBLSIZE 64
 // Set PRINTERR to 1 to print error message while calling error()
 // Make sure you set PRINTERR to 0 before you submit your code
 #define PRINTERR 1
 
-// Call this macro to print error message and exit the program
+// Call this macro to print error message and stop the compilation
 // This will also print where you called it in your program
-#define error(errorNum) { \
-    if (PRINTERR) \
-        fprintf(stderr, "error() called at %s:%d: ", __FILE__, __LINE__); \
-    err(errorNum); \
+#define error(cc, errorNum) { \
+    (cc)->errLine = __LINE__; \
+    err(cc, errorNum); \
 }
 
 // Error types
@@ -53,549 +104,1698 @@ typedef enum {
 } ErrorType;
 
 // Structure of the symbol table
+// Every name is interned once; slot is the memory slot ([slot*4]) given
+// to the variable on its first assignment, -1 until then. uses and reg
+// are only kept up with --cache.
 typedef struct {
     int val;
-    char name[MAXLEN];
+    int slot;
+    int uses;
+    int reg;
+    unsigned hash;
+    int len;
+    const char *name;
 } Symbol;
 
 // Structure of a tree node
-typedef struct _Node {
+// val is the number of an INT, the symbol of an ID, or the operator
+// character ('+', '-', '*', ...) of everything else; left and right are
+// indices into the node arena, 0 means no child
+typedef struct {
     TokenSet data;
     int val;
-    char lexeme[MAXLEN];
-    struct _Node *left;
-    struct _Node *right;
+    int left;
+    int right;
 } BTNode;
 
-int sbcount = 0;
-Symbol table[TBLSIZE];
-
 // Initialize the symbol table with builtin variables
-void initTable(void);
-// Get the value of a variable
-int getval(char *str);
-// Set the value of a variable
-int setval(char *str, int val);
-// Make a new node according to token type and lexeme
-BTNode *makeNode(TokenSet tok, const char *lexe);
-// Free the syntax tree
-void freeTree(BTNode *root);
-extern BTNode *factor(void);
-extern void statement(void);
-extern BTNode* assign_expr(void);
-extern BTNode * or_expr(void);
-extern BTNode * or_expr_tail(BTNode*left);
-extern BTNode * xor_expr(void);
-extern BTNode * xor_expr_tail(BTNode* left);
-extern BTNode * and_expr(void);
-extern BTNode * and_expr_tail(BTNode* left);
-extern BTNode * addsub_expr(void);
-extern BTNode * addsub_expr_tail(BTNode* left);
-extern BTNode * muldiv_expr(void);
-extern BTNode * muldiv_expr_tail(BTNode* left);
-extern BTNode * unary_expr(void);
-extern BTNode * factor(void);
-
-
-// Print error message and exit the program
-void err(ErrorType errorNum);
+void initTable(Compiler *cc);
+// Find a name in the symbol table, adding it if it is new
+int intern(Compiler *cc, const char *name, int len);
+// Whether a variable has been assigned by now
+int isAssigned(const Compiler *cc, int sym);
+// Load a variable into register reg, returns its value
+int getval(Compiler *cc, int sym, int reg);
+// Store register reg into a variable, returns val
+int setval(Compiler *cc, int sym, int val, int reg);
+// Make a new node in the arena and return its index
+int makeNode(Compiler *cc, TokenSet tok, int val, int left, int right);
+// Release every node of the current statement at once
+void resetNodes(Compiler *cc);
+// Compile one statement, returns 0 once the input is used up
+extern int statement(Compiler *cc);
+// Parse an expression statement, returns the root of its tree
+extern int assign_expr(Compiler *cc);
+// Parse an INT, an ID or ++/-- on an ID
+extern int factor(Compiler *cc);
+
+// An operator waiting in assign_expr(): a binary operator with its
+// precedence, a sign (PREC_UNARY, node is its 0 operand), a '(' or an
+// "ID =" / "ID +=" (precedence 0, node is the ID)
+typedef struct {
+    TokenSet tok;
+    int val;
+    int node;
+    int prec;
+} ParseOp;
+
+// Set by --flat: the parser keeps a statement in arrays in postfix order
+// instead of BTNodes, and flatEvaluate() generates its code
+int optFlat = 0;
+// What a flat node does: push a constant or a variable, nothing (the
+// variable an '=' stores to), apply an operator, store, or apply an
+// operator and store (++, --, += and -=)
+typedef enum {
+    FL_INT, FL_ID, FL_TARGET, FL_ARITH, FL_ASSIGN, FL_UPDATE
+} FlatOp;
+
+
+// Print error message and stop the compilation
+void err(Compiler *cc, ErrorType errorNum);
 
 
 // for codeGen
 // Evaluate the syntax tree
-int rflag=0;
-int ID_APPEAR = 0;
-int evaluateTree(BTNode *root);
+int evaluateTree(Compiler *cc, int root);
+
+// A node evaluateTree() is working on: state counts the children already
+// evaluated, whose values are kept in lv and rv
+typedef struct {
+    int node;
+    int state;
+    int lv;
+    int rv;
+    // --regs: the register the value of node goes to
+    int reg;
+} EvalFrame;
+// Push a frame for node on cc->evalStack, none of its children seen yet
+void pushEval(Compiler *cc, int node);
+// The next child of f in the order evaluateTree() walks them, counted in
+// f->state; 0 once they are all done. For the walks that only need to see
+// a node after its children.
+int nextChild(Compiler *cc, EvalFrame *f);
+// Set by --regs N: Sethi-Ullman numbering with at most N registers, 3 or
+// more since the program ends with x, y and z in r0 .. r2
+int optRegs = 0;
+// Same as evaluateTree() on the flat form of the statement, one pass from
+// its first node to its root
+int flatEvaluate(Compiler *cc);
+// Same as evaluateTree() but heavier subtrees first, spilling past optRegs
+int suEvaluate(Compiler *cc, int root);
+// Set by --cse: compute every value of a statement once and keep it in a register
+int optCse = 0;
+
+// A value number of cseEvaluate(): the operator and operand values it
+// was hashed from (op 0 is a constant, a is its value), how many times
+// code still reads it and the register holding it, -1 if none
+typedef struct {
+    int op;
+    int a;
+    int b;
+    int val;
+    int uses;
+    int reg;
+    // index in cseHash, -1 for values that are not hashed
+    int slot;
+} CseValue;
+// Same as evaluateTree() with common subexpressions and loads shared
+int cseEvaluate(Compiler *cc, int root);
+// Set by --superopt: trees in superTable[] get the shortest code there is
+int optSuperopt = 0;
+// superTable[] (superopt_table.h, written by bench/superopt.c) holds the
+// pure trees of up to SUPER_LEAVES leaves that have code shorter than
+// one instruction per node, with the shortest such code. A tree is keyed
+// by its nodes in prefix order, 4 bits each: OP_ADD .. OP_XOR but not
+// OP_DIV for an operator, SUPER_ZERO for the constant 0 and SUPER_LEAF
+// + i for the i-th other distinct leaf (a variable or a constant).
+#define SUPER_LEAVES 3
+#define SUPER_INPUTS 3
+#define SUPER_ZERO 8
+#define SUPER_LEAF 9
+// The code of a tree is up to SUPER_LEN instructions on r<rflag> ..
+// r<rflag + SUPER_REGS - 1> that leave the value in r<rflag>, a byte
+// each: the kind in the low 4 bits (OP_ADD .. OP_XOR or SUPER_MOVR,
+// SUPER_LOAD, SUPER_IMM), the register it writes in the next 2 and in
+// the top 2 what it reads: a register, a leaf or superImm[i]
+#define SUPER_LEN (2 * SUPER_LEAVES - 2)
+#define SUPER_REGS 3
+#define SUPER_MOVR 8
+#define SUPER_LOAD 9
+#define SUPER_IMM 10
+typedef struct {
+    unsigned key;
+    unsigned char len;
+    unsigned char code[SUPER_LEN];
+} SuperEntry;
+extern const int superImm[3];
+// Evaluate n with its code from superTable[] into r<rflag>, returns 0
+// without emitting anything if it is not there
+int superEvaluate(Compiler *cc, int n, int *val);
+// Print how many instructions --cse saved to stderr
+void reportCse(const Compiler *cc);
 // Print the syntax tree in prefix
-void printPrefix(BTNode *root);
+void printPrefix(Compiler *cc, int root);
+
+
+// for output
+// Instructions are collected in a buffer and printed by flushCode()
+typedef enum {
+    OP_MOV, OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_AND, OP_OR, OP_XOR, OP_EXIT
+} OpCode;
+
+// Kinds of operands: r<n>, [<addr>] and constants
+typedef enum {
+    A_NONE, A_REG, A_MEM, A_IMM
+} ArgKind;
+
+typedef struct {
+    unsigned char op;
+    unsigned char ka;
+    unsigned char kb;
+    int a;
+    int b;
+} Instr;
+
+// Append one instruction to the buffer
+void emit(Compiler *cc, OpCode op, ArgKind ka, int a, ArgKind kb, int b);
+// Emit the binary instruction for an operator character
+void emitArith(Compiler *cc, int op, int ra, int rb);
+// Format (and with --peephole, optimize) the buffered instructions
+void flushCode(Compiler *cc);
+// Text output goes through one large buffer written to outFd
+#define OUTBUF_SIZE (1 << 20)
+// Format one instruction at p, returns the end of the text
+char *formatInstr(char *p, const Instr *in);
+// write() whatever text is buffered, with outFd < 0 keep it and make room instead
+void flushOutput(Compiler *cc);
+// Flush everything, running the program for --run and --jit
+void finish(Compiler *cc);
+// Set by --emit=binary: fixed-width records instead of text
+int optBinary = 0;
+// A binary program is a BIN_HEADER byte header, "MPBC", version and
+// record size (16 bits each), slots and records (32 bits each), then one
+// BIN_RECORD byte record per instruction, two little-endian 32-bit
+// words: op | ka << 4 | kb << 6 | a << 8, then b. Memory operands are
+// slot numbers (address / 4), so a fits in 24 bits. Records are aligned,
+// a loader can decode them straight from the mapped file.
+#define BIN_HEADER 16
+#define BIN_RECORD 8
+#define BIN_VERSION 1
+// Encode one instruction at p, returns the end of the record
+char *encodeInstr(char *p, const Instr *in);
+// Write the header and the records kept in outBuf to outFd
+void writeBinary(Compiler *cc);
+// Set by --disasm: print the text of a binary program
+int optDisasm = 0;
+// Print the text of the binary program in the input buffer, returns the exit status
+int disassemble(Compiler *cc);
+
+
+// for vm
+// Set by --run: execute the program on the built-in machine instead of printing it
+int optRun = 0;
+
+typedef enum {
+    VM_LOADI, VM_LOAD, VM_STORE, VM_MOVR,
+    VM_ADD, VM_SUB, VM_MUL, VM_DIV, VM_AND, VM_OR, VM_XOR,
+    VM_EXIT
+} VmOp;
+
+// Memory operands are stored as slot numbers (address / 4); op is turned
+// into the address of its handler right before the program runs
+typedef struct {
+    union {
+        long op;
+        const void *h;
+    } u;
+    int a;
+    int b;
+} VmInstr;
+
+// Append instructions to the program of the machine
+void vmAssemble(Compiler *cc, const Instr *in, int n);
+// Run the program, leaving the registers in regs; returns the EXIT status
+int vmRun(Compiler *cc, int *regs);
+// Run the program and check r0..r2 against the values known at compile time
+void runProgram(Compiler *cc);
+// Print x, y and z and make sure they match what evaluateTree() computed
+void checkResult(Compiler *cc, const char *mode, const int *xyz);
+
+
+// for jit
+// Set by --jit: compile every statement to x86-64 and run it at the end,
+// on x86-64 hosts only
+int optJit = 0;
+// Append native code for one statement tree
+void jitStatement(Compiler *cc, int root);
+// Run the native program on the variable slots and check x, y and z
+void jitRun(Compiler *cc);
+
+
+// for optimizer
+// Set by --fold: simplify every tree before evaluateTree() sees it
+int optFold = 0;
+// Fold constant subtrees and algebraic identities, returns the new root
+int foldTree(Compiler *cc, int root);
+// Set by --fold-program: print only the final x, y and z, keeping the
+// statements whose divisions only the machine can judge
+int optFoldProgram = 0;
+// Set by --peephole: clean up the instruction buffer before printing it
+int optPeephole = 0;
+// Sliding-window peephole pass over code[0 .. codeCount)
+void peephole(Compiler *cc);
+// Set by --dse: buffer the whole program and drop what cannot change its outcome
+int optDse = 0;
+// Whole-program liveness over registers and memory slots, code must end in EXIT
+void eliminateDead(Compiler *cc);
+// Set by --cache N: keep up to N variables in r0 .. r<N-1> across statements
+int optCache = 0;
+// Count the reads and writes of every variable in the rest of the input
+void countUses(Compiler *cc);
+// getval() and setval() of a variable that may be in the cache
+void cacheLoad(Compiler *cc, int sym, int reg);
+void cacheStore(Compiler *cc, int sym, int reg);
+// The cache register of a variable read as the right operand of an
+// operator, which then needs no register of its own; -1 if not cached
+int cacheOperand(Compiler *cc, int sym);
+// Move x, y and z into r0 .. r2 and exit
+void cacheEpilogue(Compiler *cc);
+
+// What the peephole pass knows a register holds: kind is A_NONE, or
+// A_MEM / A_IMM with the address or the constant in v
+typedef struct {
+    int kind;
+    int v;
+} RegInfo;
+
+
+// for jobs
+// Set by -j N: compile chunks of the input on N threads
+int optJobs = 0;
+// Compile the input of cc on optJobs threads, writing the text to fd 1
+void compileParallel(Compiler *cc);
+// List the variables a statement assigns, in the order evaluateTree() would
+void scanAssigns(Compiler *cc, int root);
+
+
+// for stats
+// Set by --stats: time the phases and count what they do, printed to
+// stderr as JSON at exit and whenever SIGUSR1 arrives
+int optStats = 0;
+typedef enum {
+    PH_LEX, PH_PARSE, PH_CODEGEN, PH_OUTPUT, PH_COUNT
+} Phase;
+
+// Times are in ticks of statTicks(), turned into nanoseconds when printed.
+// ticks[PH_PARSE] has the lexing in it, ticks[PH_LEX] only has the
+// lexAhead() calls that were sampled
+typedef struct {
+    unsigned long long ticks[PH_COUNT];
+    long lexCalls;
+    long lexSamples;
+    long statements;
+    long tokens;
+    long nodes;
+    int peakNodes;
+    size_t peakNodeBytes;
+    long lookups;
+    long probes;
+    long ops[OP_EXIT + 1];
+    int peakRflag;
+    // the names of every context a batch or the server merged in, their
+    // total has none of its own
+    long symbols;
+} Stats;
+// A cheap monotonic time stamp: the TSC on x86-64, clock_gettime() elsewhere
+unsigned long long statTicks(void);
+// Ticks a time stamp itself takes, which every lexAhead() sample pays once
+extern unsigned long long statCost;
+// Start the clock and make SIGUSR1 ask for a report
+void startStats(void);
+// Add the counts and times of one context to another
+void mergeStats(Stats *to, const Stats *from);
+// Print the stats of cc to stderr as one line of JSON
+void reportStats(const Compiler *cc);
+// Print a report now if SIGUSR1 came in since the last one
+void pollStats(const Compiler *cc);
+
+
+// for batch
+// Set by --batch: every file named compiles on its own into <file>.s
+int optBatch = 0;
+// Compile paths[0 .. count) on a pool of threads, each file in a
+// context of its own; errors end only their file. total gets the counts
+// of every file for --cse and --stats. Returns the number of files that
+// could not be read or written.
+int compileBatch(Compiler *total, char **paths, int count, int threads);
+
+
+// for server
+// Set by --serve PATH: compile requests that come in on a Unix socket
+const char *optServe = NULL;
+// A request is a 32-bit little-endian length and that many bytes of
+// program text; the reply is a 32-bit status (SERVE_OK, SERVE_EXIT1 when
+// the program stopped at an error, SERVE_TOO_BIG), a 32-bit length and
+// the text a run on that program would print. A connection may send any
+// number of requests, one at a time.
+#define SERVE_OK 0
+#define SERVE_EXIT1 1
+#define SERVE_TOO_BIG 2
+#define SERVE_MAX_REQUEST (64 << 20)
+// Listen on path and serve connections on a pool of threads, never returns
+// unless the socket cannot be set up
+int serve(Compiler *total, const char *path, int threads);
+
+
+// for compiler context
+struct Compiler {
+    // lexer: the whole source is mapped (or read from a pipe) into one
+    // buffer and the lexer walks it with a cursor
+    const char *srcBegin;
+    const char *srcCur;
+    const char *srcEnd;
+    int srcMapped;
+    Lexeme lexeme;
+    Token ahead[LOOKAHEAD];
+    int aheadFirst;
+    int aheadCount;
+
+    // symbols: sbcount counts assigned variables, symcount counts interned names
+    int sbcount;
+    int symcount;
+    int symcap;
+    Symbol *table;
+    // Open addressing index over table, holds symbol index + 1 (0 is empty)
+    int *symHash;
+    int hashcap;
+    // New names are copied into chunks of this pool, freed with the table
+    char *namePool;
+    size_t namePoolLeft;
+    void *namePools;
+    // With resolve, a new name takes the slot it already has there
+    const Compiler *resolve;
+
+    // Per-statement node arena, nodes[0] is never handed out
+    BTNode *nodes;
+    int nodecount;
+    int nodecap;
+    // Operator and operand stacks of assign_expr()
+    ParseOp *ops;
+    int opTop;
+    int opCap;
+    int *operands;
+    int operandTop;
+    int operandCap;
+    // --flat: the arena as one array per field. Node i is a flatOp[i]
+    // with the constant, symbol or operator flatVal[i], its left child is
+    // i - flatLeft[i] and its right child is always i - 1
+    unsigned char *flatOp;
+    int *flatVal;
+    int *flatLeft;
+    // the value of every register flatEvaluate() has in use
+    int *flatRegs;
+    int flatCap;
+
+    // codeGen
+    int rflag;
+    int ID_APPEAR;
+    EvalFrame *evalStack;
+    int evalTop;
+    int evalCap;
+    int foldCanDrop;
+    // --fold: per node, whether canDrop() holds for it once it is folded
+    char *foldDrop;
+    int foldCap;
+    // --fold-program: where the code of the statement starts and whether
+    // it divides by zero or INT_MIN by -1 at run time
+    int foldStart;
+    int foldTrap;
+    int *suNeed;
+    char *suPure;
+    char *suIdBefore;
+    int suCap;
+    int suIds;
+    int suScratch;
+    int suSpill;
+    // per node: value number, whether the node computes it, no side
+    // effects below it and how many IDs evaluateTree() would count in it
+    int *cseVn;
+    char *cseFresh;
+    char *csePure;
+    int *cseIds;
+    int cseCap;
+    CseValue *cseVals;
+    int cseValCount;
+    int *cseHash;
+    int cseHashCap;
+    // per symbol: value it holds in the current statement if cseVarStamp matches
+    int *cseVar;
+    int *cseVarStamp;
+    int cseVarCap;
+    int cseStamp;
+    char *cseRegBusy;
+    int cseRegCap;
+    int cseRegLow;
+    long cseBase;
+    long cseSaved;
+    // --cache: variable in r<i>, -1 if free, and whether memory is behind it
+    int *cacheSym;
+    char *cacheDirty;
+
+    // output
+    Instr *code;
+    int codeCount;
+    int codeCap;
+    // Register whose "MOV r<n> " was already out when getval() hit NOTFOUND
+    int tornLoad;
+    RegInfo *regInfo;
+    int regCap;
+    // address / 4 -> register + 1 that last took the value of that slot
+    int *memReg;
+    int memCap;
+    char *regLive;
+    char *outBuf;
+    size_t outLen;
+    size_t outCap;
+    int outFd;
+    // --emit=binary: memory slots the records use, at least x, y and z
+    int binSlots;
+    // Whether the end of the input also ends the program (MOV r0 [0] ... EXIT 0)
+    int epilogue;
+
+    // vm and jit
+    VmInstr *vmCode;
+    int vmCount;
+    int vmCap;
+    int vmRegs;
+    int vmSlots;
+    unsigned char *jitBuf;
+    size_t jitLen;
+    size_t jitCap;
+    // operands jitSave() holds while a statement is generated, and the
+    // most of them that went to the spill array
+    int jitDepth;
+    int jitSpill;
+
+    // errors: failed is set once err() has been called, errLine is where
+    // error() was called from, err() longjmp()s to onError
+    int failed;
+    int errLine;
+    int quiet;
+    jmp_buf *onError;
+
+    // jobs: with scanOnly statements are only parsed, and the variables
+    // they assign for the first time in this context go to assigns[]
+    int scanOnly;
+    int *assigns;
+    int assignCount;
+    int assignCap;
+
+    // --stats
+    Stats stats;
+};
+
+// Make a fresh context; with resolve, variables take their slots from it
+Compiler *newCompiler(const Compiler *resolve);
+// Release a context and everything it allocated, but not its input
+void freeCompiler(Compiler *cc);
+// Compile statements until the input or an error stops it, returns failed
+int compile(Compiler *cc);
 
 
 /*============================================================================================
 lex implementation
 ============================================================================================*/
 
-TokenSet getToken(void)
-{
-    int i = 0;
-    char c = '\0';
-
-    while ((c = fgetc(stdin)) == ' ' || c == '\t');
-
-    if (isdigit(c)) {
-        lexeme[0] = c;
-        c = fgetc(stdin);
-        i = 1;
-        while (isdigit(c) && i < MAXLEN) {
-            lexeme[i] = c;
-            ++i;
-            c = fgetc(stdin);
-        }
-        ungetc(c, stdin);
-        lexeme[i] = '\0';
-        return INT;
+void openInput(Compiler *cc, const char *path) {
+    if (readInput(cc, path) != 0)
+        exit(1);
+}
 
-    } 
+int readInput(Compiler *cc, const char *path) {
+    int fd = 0;
+    struct stat st;
 
+    if (path != NULL && (fd = open(path, O_RDONLY)) < 0) {
+        perror(path);
+        return -1;
+    }
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            madvise(map, st.st_size, MADV_SEQUENTIAL);
+            cc->srcBegin = map;
+            cc->srcEnd = cc->srcBegin + st.st_size;
+            cc->srcCur = cc->srcBegin;
+            cc->srcMapped = 1;
+            if (fd != 0)
+                close(fd);
+            return 0;
+        }
+    }
 
-   
-    
-    else if (c == '+' || c == '-') {
+    // a pipe or a terminal: read everything into one growing buffer
+    size_t cap = 1 << 16, len = 0;
+    char *buf = malloc(cap);
+    ssize_t n;
+    while (buf != NULL && (n = read(fd, buf + len, cap - len)) > 0) {
+        len += n;
+        if (len == cap)
+            buf = realloc(buf, cap *= 2);
+    }
+    if (fd != 0)
+        close(fd);
+    if (buf == NULL) {
+        perror("read");
+        return -1;
+    }
+    cc->srcBegin = buf;
+    cc->srcEnd = buf + len;
+    cc->srcCur = cc->srcBegin;
+    return 0;
+}
 
-        
-        lexeme[0] = c;
-        c = fgetc(stdin);
-        if (c == '+') {
-            if (lexeme[0] == '+') {
-                //printf("++\n");
-                lexeme[1] = c;
-                lexeme[2] = '\0';
-                return INCDEC;
-            }
-        }
+void closeInput(Compiler *cc) {
+    if (cc->srcMapped)
+        munmap((void*)cc->srcBegin, cc->srcEnd - cc->srcBegin);
+    else
+        free((void*)cc->srcBegin);
+    cc->srcBegin = cc->srcCur = cc->srcEnd = NULL;
+    cc->srcMapped = 0;
+}
 
-        else if (c == '-') {
-            if (lexeme[0] == '-') {
-                //printf("--\n");
-                lexeme[1] = c;
-                lexeme[2] = '\0';
-                return INCDEC;
-            }
-        }
+/* Character runs
+   Blanks, numbers and names are runs of one class of characters. Most
+   are a few bytes long and a vector load does not pay for itself there,
+   so skipRun() looks at the first bytes one at a time and only a run
+   longer than that goes on to scanRun(). A vector loop only loads while
+   a whole vector is left before end, the input is not padded and may be
+   mapped right up to the end of a page; the tail is scanned a byte at a
+   time. No NUL, newline or byte >= 0x80 is in any class. */
+const unsigned char charClass[256] = {
+    ['\t'] = CC_BLANK, [' '] = CC_BLANK,
+    ['0'] = CC_DIGIT, ['1'] = CC_DIGIT, ['2'] = CC_DIGIT, ['3'] = CC_DIGIT, ['4'] = CC_DIGIT,
+    ['5'] = CC_DIGIT, ['6'] = CC_DIGIT, ['7'] = CC_DIGIT, ['8'] = CC_DIGIT, ['9'] = CC_DIGIT,
+    ['A'] = CC_ALPHA, ['B'] = CC_ALPHA, ['C'] = CC_ALPHA, ['D'] = CC_ALPHA, ['E'] = CC_ALPHA,
+    ['F'] = CC_ALPHA, ['G'] = CC_ALPHA, ['H'] = CC_ALPHA, ['I'] = CC_ALPHA, ['J'] = CC_ALPHA,
+    ['K'] = CC_ALPHA, ['L'] = CC_ALPHA, ['M'] = CC_ALPHA, ['N'] = CC_ALPHA, ['O'] = CC_ALPHA,
+    ['P'] = CC_ALPHA, ['Q'] = CC_ALPHA, ['R'] = CC_ALPHA, ['S'] = CC_ALPHA, ['T'] = CC_ALPHA,
+    ['U'] = CC_ALPHA, ['V'] = CC_ALPHA, ['W'] = CC_ALPHA, ['X'] = CC_ALPHA, ['Y'] = CC_ALPHA,
+    ['Z'] = CC_ALPHA, ['_'] = CC_ALPHA,
+    ['a'] = CC_ALPHA, ['b'] = CC_ALPHA, ['c'] = CC_ALPHA, ['d'] = CC_ALPHA, ['e'] = CC_ALPHA,
+    ['f'] = CC_ALPHA, ['g'] = CC_ALPHA, ['h'] = CC_ALPHA, ['i'] = CC_ALPHA, ['j'] = CC_ALPHA,
+    ['k'] = CC_ALPHA, ['l'] = CC_ALPHA, ['m'] = CC_ALPHA, ['n'] = CC_ALPHA, ['o'] = CC_ALPHA,
+    ['p'] = CC_ALPHA, ['q'] = CC_ALPHA, ['r'] = CC_ALPHA, ['s'] = CC_ALPHA, ['t'] = CC_ALPHA,
+    ['u'] = CC_ALPHA, ['v'] = CC_ALPHA, ['w'] = CC_ALPHA, ['x'] = CC_ALPHA, ['y'] = CC_ALPHA,
+    ['z'] = CC_ALPHA,
+};
 
-        else if (c == '=') {
-            //printf("+=\n");
-            lexeme[1] = c;
-            lexeme[2] = '\0';
-            return ADDSUB_ASSIGN;
+int lexScan = -1;
+
+// Bytes skipRun() checks one at a time before it hands over to scanRun()
+#define SCAN_SHORT 8
+
+#if defined(__x86_64__)
+// 0xff in every byte of x that is in [lo, lo + span]
+static inline __m128i inRangeSse2(__m128i x, char lo, char span) {
+    __m128i t = _mm_sub_epi8(x, _mm_set1_epi8(lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(span)), t);
+}
+
+static inline __m128i classSse2(__m128i x, int cls) {
+    __m128i in = _mm_setzero_si128();
+    if (cls & CC_BLANK)
+        in = _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(x, _mm_set1_epi8('\t')));
+    if (cls & CC_DIGIT)
+        in = _mm_or_si128(in, inRangeSse2(x, '0', 9));
+    if (cls & CC_ALPHA) {
+        // setting bit 5 folds upper case onto lower case and nothing else onto a .. z
+        in = _mm_or_si128(in, inRangeSse2(_mm_or_si128(x, _mm_set1_epi8(0x20)), 'a', 25));
+        in = _mm_or_si128(in, _mm_cmpeq_epi8(x, _mm_set1_epi8('_')));
+    }
+    return in;
+}
+
+static const char *scanSse2(const char *p, const char *end, int cls) {
+    while (end - p >= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)p);
+        unsigned out = ~(unsigned)_mm_movemask_epi8(classSse2(x, cls)) & 0xffff;
+        if (out != 0)
+            return p + __builtin_ctz(out);
+        p += 16;
+    }
+    return p;
+}
 
+__attribute__((target("avx2")))
+static inline __m256i inRangeAvx2(__m256i x, char lo, char span) {
+    __m256i t = _mm256_sub_epi8(x, _mm256_set1_epi8(lo));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8(span)), t);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i classAvx2(__m256i x, int cls) {
+    __m256i in = _mm256_setzero_si256();
+    if (cls & CC_BLANK)
+        in = _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(' ')),
+                             _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\t')));
+    if (cls & CC_DIGIT)
+        in = _mm256_or_si256(in, inRangeAvx2(x, '0', 9));
+    if (cls & CC_ALPHA) {
+        in = _mm256_or_si256(in, inRangeAvx2(_mm256_or_si256(x, _mm256_set1_epi8(0x20)), 'a', 25));
+        in = _mm256_or_si256(in, _mm256_cmpeq_epi8(x, _mm256_set1_epi8('_')));
+    }
+    return in;
+}
+
+__attribute__((target("avx2")))
+static const char *scanAvx2(const char *p, const char *end, int cls) {
+    while (end - p >= 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)p);
+        unsigned out = ~(unsigned)_mm256_movemask_epi8(classAvx2(x, cls));
+        if (out != 0)
+            return p + __builtin_ctz(out);
+        p += 32;
+    }
+    return p;
+}
+#endif
+
+static void pickScan(void) {
+    lexScan = SCAN_SCALAR;
+#if defined(__x86_64__)
+    // SSE2 is part of x86-64
+    lexScan = __builtin_cpu_supports("avx2") ? SCAN_AVX2 : SCAN_SSE2;
+#endif
+}
+
+const char *scanRun(const char *p, const char *end, int cls) {
+#if defined(__x86_64__)
+    if (lexScan == SCAN_AVX2)
+        p = scanAvx2(p, end, cls);
+    else if (lexScan == SCAN_SSE2)
+        p = scanSse2(p, end, cls);
+#endif
+    while (p < end && (charClass[(unsigned char)*p] & cls))
+        ++p;
+    return p;
+}
+
+static inline const char *skipRun(const char *p, const char *end, int cls) {
+    for (int i = 0; i < SCAN_SHORT; i++, p++)
+        if (p >= end || !(charClass[(unsigned char)*p] & cls))
+            return p;
+    return scanRun(p, end, cls);
+}
+
+TokenSet getToken(Compiler *cc)
+{
+    const char *p = cc->srcCur;
+    int c;
+
+    p = skipRun(p, cc->srcEnd, CC_BLANK);
+
+    cc->lexeme.ptr = p;
+    cc->lexeme.len = 1;
+    if (p >= cc->srcEnd) {
+        cc->lexeme.len = 0;
+        cc->srcCur = p;
+        return ENDFILE;
+    }
+    c = (unsigned char)*p++;
+    cc->srcCur = p;
+
+    if (charClass[c] & CC_DIGIT) {
+        p = skipRun(p, cc->srcEnd, CC_DIGIT);
+        cc->lexeme.len = p - cc->lexeme.ptr;
+        cc->srcCur = p;
+        return INT;
+    }
+    else if (c == '+' || c == '-') {
+        c = p < cc->srcEnd ? *p : EOF;
+        if (c == cc->lexeme.ptr[0]) {
+            cc->lexeme.len = 2;
+            cc->srcCur = p + 1;
+            return INCDEC;
         }
-        else {
-            ungetc(c, stdin);
-            lexeme[1] = '\0';
-            return ADDSUB;
+        else if (c == '=') {
+            cc->lexeme.len = 2;
+            cc->srcCur = p + 1;
+            return ADDSUB_ASSIGN;
         }
-        
-        
-    } else if (c == '*' || c == '/') {
-        lexeme[0] = c;
-        lexeme[1] = '\0';
+        return ADDSUB;
+    }
+    else if (c == '*' || c == '/') {
         return MULDIV;
-    } else if (c == '\n') {
-        lexeme[0] = '\0';
+    }
+    else if (c == '\n') {
+        cc->lexeme.len = 0;
         return END;
-    } else if (c == '=') {
-        strcpy(lexeme, "=");
+    }
+    else if (c == '=') {
         return ASSIGN;
-    } else if (c == '(') {
-        strcpy(lexeme, "(");
+    }
+    else if (c == '(') {
         return LPAREN;
-    } else if (c == ')') {
-        strcpy(lexeme, ")");
+    }
+    else if (c == ')') {
         return RPAREN;
-    } else if (isalpha(c) || c=='_') {
-        lexeme[0] = c;
-        char nextchar = getchar();
-        int index = 1;
-        while (isalpha(nextchar) || nextchar == '_' || isdigit(nextchar) && index<MAXLEN) {
-            lexeme[index] = nextchar;
-            index += 1;
-            nextchar = getchar();
-        }
-        ungetc(nextchar, stdin);
-        lexeme[index] = '\0';
+    }
+    else if (charClass[c] & CC_ALPHA) {
+        p = skipRun(p, cc->srcEnd, CC_IDENT);
+        cc->lexeme.len = p - cc->lexeme.ptr;
+        cc->srcCur = p;
         return ID;
-    } 
+    }
     else if (c == '&') {
-        lexeme[0] = '&';
-        lexeme[1] = '\0';
         return AND;
     }
     else if (c == '|') {
-        lexeme[0] = '|';
-        lexeme[1] = '\0';
         return OR;
     }
     else if (c == '^') {
-        lexeme[0] = '^';
-        lexeme[1] = '\0';
         return XOR;
     }
-    
-    else if (c == EOF) {
-        return ENDFILE;
-    } 
     else {
         return UNKNOWN;
     }
-    
 }
 
-void advance(void) {
-    curToken = getToken();
+// --stats times one call in LEX_SAMPLE, a time stamp costs more than a
+// token; not the first one, which pays for a cold start
+#define LEX_SAMPLE 64
+
+static void lexAhead(Compiler *cc, int k) {
+    int timed = optStats && cc->stats.lexCalls++ % LEX_SAMPLE == LEX_SAMPLE - 1;
+    unsigned long long t0 = timed ? statTicks() : 0;
+
+    while (cc->aheadCount <= k) {
+        TokenSet tok = getToken(cc);
+        Token *t;
+        if (tok == UNKNOWN)
+            continue;
+        t = &cc->ahead[(cc->aheadFirst + cc->aheadCount++) & (LOOKAHEAD - 1)];
+        t->tok = tok;
+        t->lexeme = cc->lexeme;
+        cc->stats.tokens++;
+    }
+    if (timed) {
+        // a sample the thread was preempted in would count 64 times over
+        t0 = statTicks() - t0;
+        if (t0 < statCost * 1024) {
+            cc->stats.ticks[PH_LEX] += t0;
+            cc->stats.lexSamples++;
+        }
+    }
+}
+
+TokenSet peekToken(Compiler *cc, int k) {
+    if (cc->aheadCount <= k)
+        lexAhead(cc, k);
+    return cc->ahead[(cc->aheadFirst + k) & (LOOKAHEAD - 1)].tok;
+}
+
+void advance(Compiler *cc) {
+    if (cc->aheadCount == 0)
+        lexAhead(cc, 0);
+    cc->aheadFirst = (cc->aheadFirst + 1) & (LOOKAHEAD - 1);
+    cc->aheadCount--;
 }
 
-int match(TokenSet token) {
-    if (curToken == UNKNOWN)
-        advance();
-    return token == curToken;
+int match(Compiler *cc, TokenSet token) {
+    return token == peekToken(cc, 0);
 }
 
 
 
-char *getLexeme(void) {
-    return lexeme;
+Lexeme getLexeme(Compiler *cc) {
+    if (cc->aheadCount == 0)
+        lexAhead(cc, 0);
+    return cc->ahead[cc->aheadFirst].lexeme;
 }
 
 /*============================================================================================
 parser implementation
 ============================================================================================*/
 
-void initTable(void) {
-    strcpy(table[0].name, "x");
-    table[0].val = 0;
-    strcpy(table[1].name, "y");
-    table[1].val = 0;
-    strcpy(table[2].name, "z");
-    table[2].val = 0;
-    sbcount = 3;
-}
-
-int getval(char *str) {
-    int i = 0;
-    //因為她會存入最新的一個就直接放rflag
-    for (i = 0; i < sbcount; i++) {//改括號
-        if (strcmp(str, table[i].name) == 0) {
-            printf("[%d]", i * 4);
-            
-            return table[i].val;
-        }
-    }
-
-    if (sbcount >= TBLSIZE)
-        error(RUNOUT);
-    //new_variable += 1;
-    err(NOTFOUND);
-    
-    strcpy(table[sbcount].name, str); //增加新變數
-    printf("MOV r%d [%d]\n", rflag, i * 4);
-    rflag += 1;
-    table[sbcount].val = 0;
-    sbcount++;
-    return 0;
+void initTable(Compiler *cc) {
+    cc->symcap = TBLSIZE;
+    cc->table = (Symbol*)malloc(cc->symcap * sizeof(Symbol));
+    cc->hashcap = 2 * TBLSIZE;
+    cc->symHash = (int*)calloc(cc->hashcap, sizeof(int));
+    cc->symcount = 0;
+    cc->sbcount = 0;
+    intern(cc, "x", 1);
+    intern(cc, "y", 1);
+    intern(cc, "z", 1);
+    for (; cc->sbcount < 3; cc->sbcount++)
+        cc->table[cc->sbcount].slot = cc->sbcount;
+}
+
+static unsigned hashName(const char *name, int len) {
+    unsigned h = 2166136261u;
+    for (int i = 0; i < len; i++)
+        h = (h ^ (unsigned char)name[i]) * 16777619u;
+    return h;
 }
 
-int setval(char *str, int val) {
-    int i = 0;
-    //printf("%s", str);
+// Copy a new name into a chunked string pool, names live as long as the table
+static const char *saveName(Compiler *cc, const char *name, int len) {
+    char *p;
 
-    for (i = 0; i < sbcount; i++) {
-        if (strcmp(str, table[i].name) == 0) {
-            
-            
-            table[i].val = val;
+    // every chunk starts with a pointer to the previous one
+    if ((size_t)len + 1 > cc->namePoolLeft) {
+        size_t size = len + 1 > 65536 ? len + 1 : 65536;
+        void **chunk = (void**)malloc(sizeof(void*) + size);
+        *chunk = cc->namePools;
+        cc->namePools = chunk;
+        cc->namePool = (char*)(chunk + 1);
+        cc->namePoolLeft = size;
+    }
+    p = cc->namePool;
+    memcpy(p, name, len);
+    p[len] = '\0';
+    cc->namePool += len + 1;
+    cc->namePoolLeft -= len + 1;
+    return p;
+}
 
-            printf("[%d]", i*4);
-	
-            return val;
+static void growTable(Compiler *cc) {
+    int *old = cc->symHash;
+    int oldcap = cc->hashcap;
+
+    cc->hashcap *= 2;
+    cc->symHash = (int*)calloc(cc->hashcap, sizeof(int));
+    for (int i = 0; i < oldcap; i++) {
+        if (old[i]) {
+            unsigned h = cc->table[old[i] - 1].hash & (cc->hashcap - 1);
+            while (cc->symHash[h])
+                h = (h + 1) & (cc->hashcap - 1);
+            cc->symHash[h] = old[i];
         }
     }
+    free(old);
+}
+
+// Hash index of name: either its entry or the empty entry it would take
+static unsigned findName(const Compiler *cc, const char *name, int len, unsigned hash) {
+    unsigned h = hash & (cc->hashcap - 1);
+
+    while (cc->symHash[h]) {
+        const Symbol *sym = &cc->table[cc->symHash[h] - 1];
+        if (sym->hash == hash && sym->len == len && memcmp(sym->name, name, len) == 0)
+            break;
+        h = (h + 1) & (cc->hashcap - 1);
+    }
+    return h;
+}
+
+int intern(Compiler *cc, const char *name, int len) {
+    unsigned hash = hashName(name, len);
+    unsigned h = findName(cc, name, len, hash);
+    Symbol *sym;
+
+    if (optStats) {
+        cc->stats.lookups++;
+        cc->stats.probes += ((h - hash) & (cc->hashcap - 1)) + 1;
+    }
+    if (cc->symHash[h])
+        return cc->symHash[h] - 1;
+
+    if (cc->symcount == cc->symcap) {
+        cc->symcap *= 2;
+        cc->table = (Symbol*)realloc(cc->table, cc->symcap * sizeof(Symbol));
+    }
+    sym = &cc->table[cc->symcount];
+    sym->val = 0;
+    sym->slot = -1;
+    sym->uses = 0;
+    sym->reg = -1;
+    if (cc->resolve != NULL) {
+        const Compiler *rc = cc->resolve;
+        unsigned rh = findName(rc, name, len, hash);
+        if (rc->symHash[rh])
+            sym->slot = rc->table[rc->symHash[rh] - 1].slot;
+    }
+    sym->hash = hash;
+    sym->len = len;
+    sym->name = saveName(cc, name, len);
+    cc->symHash[h] = ++cc->symcount;
+    if (2 * cc->symcount > cc->hashcap)
+        growTable(cc);
+    return cc->symcount - 1;
+}
+
+// Slots are handed out in the order variables are first assigned, so a
+// variable is assigned once sbcount has gone past its slot. That also holds
+// for slots that came from resolve before the assignment ran.
+int isAssigned(const Compiler *cc, int i) {
+    int slot = cc->table[i].slot;
+    return slot >= 0 && slot < cc->sbcount;
+}
+
+int getval(Compiler *cc, int i, int reg) {
+    Symbol *sym = &cc->table[i];
+
+    //還沒被assign過的變數不能用
+    if (!isAssigned(cc, i)) {
+        cc->tornLoad = reg;
+        err(cc, NOTFOUND);
+    }
+    if (optCache)
+        cacheLoad(cc, i, reg);
+    else if (optFoldProgram)
+        // --fold-program never stores, the value is known anyway
+        emit(cc, OP_MOV, A_REG, reg, A_IMM, sym->val);
+    else
+        emit(cc, OP_MOV, A_REG, reg, A_MEM, sym->slot * 4);
+    return sym->val;
+}
 
+int setval(Compiler *cc, int i, int val, int reg) {
+    Symbol *sym = &cc->table[i];
 
-    if (sbcount >= TBLSIZE)
-        error(RUNOUT);
-    
-    strcpy(table[sbcount].name, str);
-    table[sbcount].val = val;
-    printf("[%d]", sbcount * 4);
-    sbcount++;
-    
-    //if (rflag > 0) rflag--;//not sure
+    //第一次assign才給新的slot
+    if (sym->slot < 0)
+        sym->slot = cc->sbcount;
+    if (sym->slot == cc->sbcount)
+        cc->sbcount++;
+    sym->val = val;
+    if (optCache)
+        cacheStore(cc, i, reg);
+    else if (!optFoldProgram)
+        emit(cc, OP_MOV, A_MEM, sym->slot * 4, A_REG, reg);
     return val;
 }
 
-BTNode *makeNode(TokenSet tok, const char *lexe) {
+/* Flat nodes (--flat)
+   assign_expr() makes a node only once both its children are made, and
+   all of the left one before any of the right one: the sign's 0 and the
+   ID of "ID =" as the operator goes on the stack, before the operand
+   that follows. So the arena is already in postfix order and the root
+   is the last node; flatNode() just writes it column by column, and a
+   pass from the first node to the last is a post-order walk. The ID an
+   '=' stores to is marked when the '=' is made, that pass skips it the
+   way evaluateTree() never walks into it. */
+static int flatNode(Compiler *cc, TokenSet tok, int val, int left) {
+    int i = cc->nodecount;
+    FlatOp op;
+
+    if (i >= cc->flatCap) {
+        cc->flatCap = cc->flatCap ? cc->flatCap * 2 : 256;
+        cc->flatOp = (unsigned char*)realloc(cc->flatOp, cc->flatCap);
+        cc->flatVal = (int*)realloc(cc->flatVal, cc->flatCap * sizeof(int));
+        cc->flatLeft = (int*)realloc(cc->flatLeft, cc->flatCap * sizeof(int));
+        cc->flatRegs = (int*)realloc(cc->flatRegs, cc->flatCap * sizeof(int));
+        cc->stats.peakNodeBytes = cc->flatCap * (1 + 2 * sizeof(int));
+    }
+    switch (tok) {
+        case INT: op = FL_INT; break;
+        case ID: op = FL_ID; break;
+        case ASSIGN:
+            op = FL_ASSIGN;
+            cc->flatOp[left] = FL_TARGET;
+            break;
+        case INCDEC:
+        case ADDSUB_ASSIGN: op = FL_UPDATE; break;
+        default: op = FL_ARITH; break;
+    }
+    cc->flatOp[i] = op;
+    cc->flatVal[i] = val;
+    cc->flatLeft[i] = left ? i - left : 0;
+    return cc->nodecount++;
+}
+
+int makeNode(Compiler *cc, TokenSet tok, int val, int left, int right) {
     BTNode* node = NULL;
-    node=(BTNode*)malloc(sizeof(BTNode));
-    strcpy(node->lexeme, lexe);
+    if (optFlat)
+        return flatNode(cc, tok, val, left);
+    if (cc->nodecount >= cc->nodecap) {
+        cc->nodecap = cc->nodecap ? cc->nodecap * 2 : 256;
+        cc->nodes = (BTNode*)realloc(cc->nodes, cc->nodecap * sizeof(BTNode));
+        cc->stats.peakNodeBytes = cc->nodecap * sizeof(BTNode);
+    }
+    node = &cc->nodes[cc->nodecount];
     node->data = tok;
-    node->val = 0;
-    node->left = NULL;
-    node->right = NULL;
-    return node;
+    node->val = val;
+    node->left = left;
+    node->right = right;
+    return cc->nodecount++;
+}
+
+void resetNodes(Compiler *cc) {
+    cc->stats.nodes += cc->nodecount - 1;
+    if (cc->nodecount - 1 > cc->stats.peakNodes)
+        cc->stats.peakNodes = cc->nodecount - 1;
+    cc->nodecount = 1;
 }
 
-void freeTree(BTNode *root) {
-    if (root != NULL) {
-        freeTree(root->left);
-        freeTree(root->right);
-        free(root);
+// Same result as atoi() on the lexeme: strtol() saturation, then int conversion
+static int lexemeToInt(Lexeme lx) {
+    long v = 0;
+    for (int i = 0; i < lx.len; i++) {
+        int d = lx.ptr[i] - '0';
+        if (v > (LONG_MAX - d) / 10) {
+            v = LONG_MAX;
+            break;
+        }
+        v = v * 10 + d;
     }
+    return (int)v;
 }
 
 
 
-void statement(void) {
-    BTNode* retp = NULL;
+int statement(Compiler *cc) {
+    int retp = 0;
+    unsigned long long t0 = 0;
 
-    if (match(ENDFILE)) {
-        printf("MOV r0 [0]\n");
-        printf("MOV r1 [4]\n");
-        printf("MOV r2 [8]\n");
-        printf("EXIT 0\n");
-            
-        exit(0);
+    if (match(cc, ENDFILE)) {
+        if (cc->epilogue && optCache) {
+            cacheEpilogue(cc);
+        }
+        else if (cc->epilogue && optFoldProgram) {
+            emit(cc, OP_MOV, A_REG, 0, A_IMM, cc->table[0].val);
+            emit(cc, OP_MOV, A_REG, 1, A_IMM, cc->table[1].val);
+            emit(cc, OP_MOV, A_REG, 2, A_IMM, cc->table[2].val);
+            emit(cc, OP_EXIT, A_IMM, 0, A_NONE, 0);
+        }
+        else if (cc->epilogue) {
+            emit(cc, OP_MOV, A_REG, 0, A_MEM, 0);
+            emit(cc, OP_MOV, A_REG, 1, A_MEM, 4);
+            emit(cc, OP_MOV, A_REG, 2, A_MEM, 8);
+            emit(cc, OP_EXIT, A_IMM, 0, A_NONE, 0);
+        }
+        return 0;
     }
-    else if (match(END)) {
+    else if (match(cc, END)) {
         
         //printf(">> ");
-        advance();
+        advance(cc);
     }
     else {
-        retp = assign_expr();
-        if (match(END)) {
-            //printf("%d\n", evaluateTree(retp));
-            int num=evaluateTree(retp);
-            //printf("num:%d", num);
+        cc->foldStart = cc->codeCount;
+        cc->foldTrap = 0;
+        retp = assign_expr(cc);
+        if (match(cc, END)) {
+            cc->stats.statements++;
+            if (cc->scanOnly) {
+                scanAssigns(cc, retp);
+            }
+            else {
+                if (optStats)
+                    t0 = statTicks();
+                if (optFold)
+                    retp = foldTree(cc, retp);
+                //printf("%d\n", evaluateTree(retp));
+                if (optRegs)
+                    suEvaluate(cc, retp);
+                else if (optCse)
+                    cseEvaluate(cc, retp);
+                else if (optFlat)
+                    flatEvaluate(cc);
+                else
+                    evaluateTree(cc, retp);
+                // every value is known, only a trapping division needs the code
+                if (optFoldProgram && !cc->foldTrap)
+                    cc->codeCount = cc->foldStart;
+                if (optJit)
+                    jitStatement(cc, retp);
+                if (optStats)
+                    cc->stats.ticks[PH_CODEGEN] += statTicks() - t0;
+            }
             //printf("Prefix traversal: ");
             //printPrefix(retp);
             //printf("\n");
-            freeTree(retp);
+            resetNodes(cc);
+            if (cc->codeCount >= 65536 && !optDse)
+                flushCode(cc);
             //printf(">> ");
-            advance();
+            advance(cc);
         }
         else {
-            error(SYNTAXERR);
+            error(cc, SYNTAXERR);
         }
     }
+    return 1;
 }
-//注意如果那麼早用如果是x++就在抓完x後會想去抓=或+=
-    //應該要連用str2,str3,如果不對就unget
-    //然後curtoken要設成unknown
-
+/* Operator-precedence parser
+   assign_expr() parses a whole statement without recursion. Operators
+   wait on cc->ops until an operator that binds no tighter, a ')' or the
+   end of the expression pops them, and the popped operator takes its
+   operands from cc->operands. The trees are the same the grammar
+       assign_expr : ID ('=' | '+=' | '-=') assign_expr | or_expr
+       or_expr ... muldiv_expr : left-associative binary operators
+       unary_expr  : ('+' | '-') unary_expr | factor
+       factor      : INT | ID | ('++' | '--') ID | '(' assign_expr ')'
+   builds: "ID =" is only taken at the start of an expression, which one
+   token of lookahead past the ID tells, a sign becomes 0 +/- operand and
+   binds tighter than any binary operator. */
+#define PREC_UNARY 6
 
-    //運作過程 一開始main先statement()
-    //如果讀到不是+=或=就ungets然後回到第一位
-    //再往下跑一層邏輯再gettoken的時候就可以迴避掉那個問題了
-extern BTNode* assign_expr(void) { 
-    BTNode *retp,*left;
-    char str2[60]={'\0'};
-    char str3[60]={'\0'};
-    if(match(ID)){
-        left=makeNode(ID,getLexeme());
-        advance();
-        strcpy(str2,left->lexeme);
-        strcpy(str3,getLexeme());
-        if(match(END)) return left;
-        else if(match(ASSIGN)){
-            retp=makeNode(ASSIGN,getLexeme());
-            advance();
-            retp->left=left;
-            retp->right=assign_expr();
-        }
-        else if (match(ADDSUB_ASSIGN)){
-            retp=makeNode(ADDSUB_ASSIGN,getLexeme());
-            advance();
-            retp->left=left;
-            retp->right=assign_expr();           
-        }
-        else{
-            for(int i=strlen(str3)-1;i>=0;i--) ungetc(str3[i],stdin);       
-            for(int i=strlen(str2)-1;i>=0;i--) ungetc(str2[i],stdin);     
-            settoken();
-            return or_expr();
-        }
-        return retp;
+static int binaryPrec(Compiler *cc) {
+    switch (peekToken(cc, 0)) {
+        case OR: return 1;
+        case XOR: return 2;
+        case AND: return 3;
+        case ADDSUB: return 4;
+        case MULDIV: return 5;
+        default: return 0;
     }
-    else return or_expr();
 }
 
+static void pushOp(Compiler *cc, TokenSet tok, int val, int node, int prec) {
+    ParseOp *op;
+    if (cc->opTop == cc->opCap) {
+        cc->opCap = cc->opCap ? cc->opCap * 2 : 64;
+        cc->ops = (ParseOp*)realloc(cc->ops, cc->opCap * sizeof(ParseOp));
+    }
+    op = &cc->ops[cc->opTop++];
+    op->tok = tok;
+    op->val = val;
+    op->node = node;
+    op->prec = prec;
+}
 
-extern BTNode* or_expr(void) {
-    BTNode* node = xor_expr();
-    return or_expr_tail(node);
+static void pushOperand(Compiler *cc, int node) {
+    if (cc->operandTop == cc->operandCap) {
+        cc->operandCap = cc->operandCap ? cc->operandCap * 2 : 64;
+        cc->operands = (int*)realloc(cc->operands, cc->operandCap * sizeof(int));
+    }
+    cc->operands[cc->operandTop++] = node;
+}
 
+// Build the nodes of every waiting operator that binds at least as tight as prec
+static void reduceOps(Compiler *cc, int prec) {
+    while (cc->opTop > 0 && cc->ops[cc->opTop - 1].prec >= prec) {
+        ParseOp *op = &cc->ops[--cc->opTop];
+        int right = cc->operands[--cc->operandTop];
+        int left = op->prec == PREC_UNARY ? op->node : cc->operands[--cc->operandTop];
+        cc->operands[cc->operandTop++] = makeNode(cc, op->tok, op->val, left, right);
+    }
 }
 
+extern int assign_expr(Compiler *cc) {
+    // whether "ID =" may come next: at the start, after '(' and after another "ID ="
+    int start = 1;
 
-extern BTNode* or_expr_tail(BTNode* left) {
-    BTNode* node = NULL;
-    if (match(OR)) {
-        node = makeNode(OR, getLexeme());
-        advance();
-        node->left = left;
-        node->right = xor_expr();
-        return or_expr_tail(node);
+    cc->opTop = 0;
+    cc->operandTop = 0;
+    for (;;) {
+        int node = 0, prec;
 
-    }
-    else {
-        return left;
-    }
+        // the operand, after any "ID =", '(' and signs in front of it
+        if (start && match(cc, ID)
+            && (peekToken(cc, 1) == ASSIGN || peekToken(cc, 1) == ADDSUB_ASSIGN)) {
+            node = makeNode(cc, ID, intern(cc, getLexeme(cc).ptr, getLexeme(cc).len), 0, 0);
+            advance(cc);
+            pushOp(cc, peekToken(cc, 0), match(cc, ASSIGN) ? '=' : getLexeme(cc).ptr[0], node, 0);
+            advance(cc);
+            continue;
+        }
+        else if (match(cc, ADDSUB)) {
+            int op = getLexeme(cc).ptr[0];
+            pushOp(cc, ADDSUB, op, makeNode(cc, INT, 0, 0, 0), PREC_UNARY);
+            advance(cc);
+            start = 0;
+            continue;
+        }
+        else if (match(cc, LPAREN)) {
+            pushOp(cc, LPAREN, '(', 0, 0);
+            advance(cc);
+            start = 1;
+            continue;
+        }
+        else {
+            node = factor(cc);
+        }
+        pushOperand(cc, node);
+        start = 0;
 
-}
-extern BTNode* xor_expr(void) {
-    BTNode* node = and_expr();
-    return xor_expr_tail(node);
+        // binary operators, ')' and the ends of assignments after it
+        while ((prec = binaryPrec(cc)) == 0) {
+            ParseOp *top;
+            reduceOps(cc, 1);
+            if (cc->opTop == 0)
+                return cc->operands[0];
+            top = &cc->ops[--cc->opTop];
+            if (top->tok == LPAREN) {
+                if (!match(cc, RPAREN))
+                    error(cc, MISPAREN);
+                advance(cc);
+            }
+            else {
+                node = cc->operands[--cc->operandTop];
+                cc->operands[cc->operandTop++] = makeNode(cc, top->tok, top->val, top->node, node);
+            }
+        }
+        reduceOps(cc, prec);
+        pushOp(cc, peekToken(cc, 0), getLexeme(cc).ptr[0], 0, prec);
+        advance(cc);
+    }
 }
 
-extern BTNode* xor_expr_tail(BTNode* left) {
-    BTNode* node = NULL;
-    if (match(XOR)) {
-        node = makeNode(XOR, getLexeme());
-        advance();
-        node->left = left;
-        node->right = and_expr();
-        return xor_expr_tail(node);
+extern int factor(Compiler *cc) {
+    int retp = 0;
 
+    if (match(cc, INT)) {
+        retp = makeNode(cc, INT, lexemeToInt(getLexeme(cc)), 0, 0);
+        advance(cc);
+    }
+    else if (match(cc, ID)) {
+        retp = makeNode(cc, ID, intern(cc, getLexeme(cc).ptr, getLexeme(cc).len), 0, 0);
+        advance(cc);
+    }
+    else if (match(cc, INCDEC)) {
+        int op = getLexeme(cc).ptr[0];
+        advance(cc);
+        if (match(cc, ID)) {
+            int left = makeNode(cc, ID, intern(cc, getLexeme(cc).ptr, getLexeme(cc).len), 0, 0);
+            advance(cc);
+            retp = makeNode(cc, INCDEC, op, left, makeNode(cc, INT, 1, 0, 0));
+        }
+        else {
+            error(cc, UNDEFINED);
+        }
     }
     else {
-        return left;
+        error(cc, NOTNUMID);
     }
+    return retp;
 
 }
 
 
-extern BTNode* and_expr(void) {
-    BTNode* node = addsub_expr();
-    return and_expr_tail(node);
-
-}
 
 
-extern BTNode* and_expr_tail(BTNode* left) {
-    BTNode* node = NULL;
+// Say where error() was called, if it was
+static void reportError(const Compiler *cc) {
+    if (PRINTERR && cc->errLine)
+        fprintf(stderr, "error() called at %s:%d: ", __FILE__, cc->errLine);
+}
 
-    if (match(AND)) {
-        node = makeNode(AND, getLexeme());
-        advance();
-        node->left = left;
-        node->right = addsub_expr();
-        return and_expr_tail(node);
+void err(Compiler *cc, ErrorType errorNum) {
+    cc->failed = 1;
+    // --fold-program keeps what the statement did so far only if it traps
+    if (optFoldProgram && !cc->foldTrap) {
+        cc->codeCount = cc->foldStart;
+        cc->tornLoad = -1;
     }
-    else {
-        return left;
+    if (PRINTERR) {
+        if (!cc->quiet)
+            reportError(cc);
+        emit(cc, OP_EXIT, A_IMM, 1, cc->tornLoad >= 0 ? A_REG : A_NONE, cc->tornLoad);
+        
     }
-
+    longjmp(*cc->onError, 1);
 }
 
 
-extern BTNode* addsub_expr(void) {
-    BTNode* node = muldiv_expr();
-    return addsub_expr_tail(node);
+/*============================================================================================
+optimizer implementation
+============================================================================================*/
 
+// Subtrees may only be dropped (x*0, x-x, ...) when that cannot change the
+// outcome of the statement: no side effects, every variable already
+// assigned (so NOTFOUND still fires), and no division in the statement
+// (foldCanDrop), because evaluateTree() decides divide-by-zero errors
+// from ID_APPEAR
+static int isConst(Compiler *cc, int n, int v) {
+    return cc->nodes[n].data == INT && cc->nodes[n].val == v;
 }
 
+// The "0 - e" subtree assign_expr() builds for unary minus
+static int isNeg(Compiler *cc, int n) {
+    return cc->nodes[n].data == ADDSUB && cc->nodes[n].val == '-' && isConst(cc, cc->nodes[n].left, 0);
+}
 
-extern BTNode* addsub_expr_tail(BTNode* left) {
-    BTNode* node = NULL;
+static int hasDiv(Compiler *cc, int root) {
+    cc->evalTop = 0;
+    pushEval(cc, root);
+    while (cc->evalTop > 0) {
+        EvalFrame *f = &cc->evalStack[cc->evalTop - 1];
+        int child = nextChild(cc, f);
 
-    if (match(ADDSUB)) {
-        node = makeNode(ADDSUB, getLexeme());
-        advance();
-        node->left = left;
-        node->right = muldiv_expr();
-        return addsub_expr_tail(node);
-    }
-    else {
-        return left;
+        if (child != 0) {
+            pushEval(cc, child);
+            continue;
+        }
+        if (cc->nodes[f->node].data == MULDIV && cc->nodes[f->node].val == '/')
+            return 1;
+        cc->evalTop--;
     }
-
+    return 0;
 }
 
-
-extern BTNode* muldiv_expr(void) {
-    BTNode* node = unary_expr();
-    return muldiv_expr_tail(node);
-
+// Reads foldDrop[] of the children, so only for nodes already folded
+static int canDrop(Compiler *cc, int n) {
+    switch (cc->nodes[n].data) {
+        case INT:
+            return 1;
+        case ID:
+            return isAssigned(cc, cc->nodes[n].val);
+        case ASSIGN:
+        case ADDSUB_ASSIGN:
+        case INCDEC:
+            return 0;
+        default:
+            return cc->foldDrop[cc->nodes[n].left] && cc->foldDrop[cc->nodes[n].right];
+    }
 }
 
-extern BTNode* muldiv_expr_tail(BTNode* left) {
-    BTNode* node = NULL;
+static int sameVar(Compiler *cc, int a, int b) {
+    return cc->nodes[a].data == ID && cc->nodes[b].data == ID && cc->nodes[a].val == cc->nodes[b].val;
+}
 
-    if (match(MULDIV)) {
-        node = makeNode(MULDIV, getLexeme());
-        advance();
-        node->left = left;
-        node->right = unary_expr();
-        return muldiv_expr_tail(node);
-    }
-    else {
-        return left;
+// 32-bit wraparound arithmetic, the same results evaluateTree() produces
+static int calc(int op, int lv, int rv) {
+    unsigned a = lv, b = rv;
+    switch (op) {
+        case '+': return (int)(a + b);
+        case '-': return (int)(a - b);
+        case '*': return (int)(a * b);
+        case '/': return rv == -1 ? (int)(0u - a) : lv / rv;
+        case '&': return lv & rv;
+        case '|': return lv | rv;
+        case '^': return lv ^ rv;
     }
+    return 0;
+}
 
+static int makeConst(Compiler *cc, int n, int v) {
+    cc->nodes[n].data = INT;
+    cc->nodes[n].val = v;
+    cc->nodes[n].left = 0;
+    cc->nodes[n].right = 0;
+    return n;
 }
 
+// Every rewrite that keeps n goes round again
+static int simplify(Compiler *cc, int n) {
+    BTNode *node;
+    int op, l, r;
 
-extern BTNode* unary_expr(void) {
-    BTNode* retp = NULL;
-    if (match(ADDSUB)) {
-        retp = makeNode(ADDSUB, getLexeme());
-        advance();
-        retp->left = makeNode(INT, "0");
-        
-        
+again:
+    node = &cc->nodes[n];
+    op = node->val;
+    l = node->left;
+    r = node->right;
 
-        
-        retp->right = unary_expr();
-        
-        
+    // constant subtree, but keep divisions that evaluateTree() has to judge
+    if (cc->nodes[l].data == INT && cc->nodes[r].data == INT) {
+        int lv = cc->nodes[l].val, rv = cc->nodes[r].val;
+        if (op == '/' && (rv == 0 || (lv == INT_MIN && rv == -1)))
+            return n;
+        return makeConst(cc, n, calc(op, lv, rv));
     }
-    else {
-        return factor();
+
+    // unary minus: a - (0 - e) => a + e, a + (0 - e) => a - e, (0 - a) * (0 - b) => a * b
+    if ((op == '+' || op == '-') && isNeg(cc, r)) {
+        node->val = op == '+' ? '-' : '+';
+        node->right = cc->nodes[r].right;
+        goto again;
     }
-    return retp;
-}
-extern BTNode* factor(void) {
-    BTNode* retp = NULL;
-
-    if (match(INT)) {
-        retp = makeNode(INT, getLexeme());
-        advance();
-    }
-    else if (match(ID)) {
-        retp = makeNode(ID, getLexeme());
-        advance();
-    }
-    else if (match(INCDEC)) {
-        retp = makeNode(INCDEC,getLexeme());
-        //printf("%s", retp->lexeme);
-        advance();
-        if (match(ID)) {
-            retp->left = makeNode(ID, getLexeme());
-            //printf("%s", retp->left->lexeme);
-            advance();
-            retp->right = makeNode(INT, "1");
-            
-            //printf("finish");
+    if (op == '*' && isNeg(cc, l) && isNeg(cc, r)) {
+        node->left = cc->nodes[l].right;
+        node->right = cc->nodes[r].right;
+        goto again;
+    }
+    if (op == '*' && isNeg(cc, l) && cc->nodes[r].data == INT) {
+        node->left = cc->nodes[l].right;
+        cc->nodes[r].val = calc('-', 0, cc->nodes[r].val);
+        goto again;
+    }
+
+    // (a + c) + k => a + (c + k), also for - and for chains of * & | ^
+    if (cc->nodes[r].data == INT && cc->nodes[l].data == node->data && cc->nodes[cc->nodes[l].right].data == INT
+        && (node->data == ADDSUB || op == '*' || (op == cc->nodes[l].val && node->data != MULDIV))) {
+        int c = cc->nodes[cc->nodes[l].right].val, k = cc->nodes[r].val;
+        if (node->data == ADDSUB) {
+            k = calc('+', cc->nodes[l].val == '+' ? c : calc('-', 0, c), op == '+' ? k : calc('-', 0, k));
+            op = '+';
+            if (k < 0 && k != INT_MIN) {
+                k = -k;
+                op = '-';
+            }
+        }
+        else if (cc->nodes[l].val == '*') {
+            k = calc(op, c, k);
         }
         else {
-            error(UNDEFINED);
+            return n;
         }
+        node->val = op;
+        node->left = cc->nodes[l].left;
+        cc->nodes[r].val = k;
+        goto again;
     }
-    
-    else if (match(LPAREN)) {
-        advance();
-        retp = assign_expr();
-        if (match(RPAREN))
-            advance();
-        else
-            error(MISPAREN);
-    }
-    else {
-        error(NOTNUMID);
-    }
-    return retp;
 
+    switch (op) {
+        case '+':
+            if (isConst(cc, r, 0)) return l;
+            if (isConst(cc, l, 0)) return r;
+            break;
+        case '-':
+            if (isConst(cc, r, 0)) return l;
+            if (cc->foldCanDrop && sameVar(cc, l, r) && canDrop(cc, l)) return makeConst(cc, n, 0);
+            break;
+        case '*':
+            if (isConst(cc, r, 1)) return l;
+            if (isConst(cc, l, 1)) return r;
+            if (cc->foldCanDrop && (isConst(cc, r, 0) || isConst(cc, l, 0)) && canDrop(cc, l) && canDrop(cc, r))
+                return makeConst(cc, n, 0);
+            break;
+        case '/':
+            if (isConst(cc, r, 1)) return l;
+            break;
+        case '&':
+            if (isConst(cc, r, -1)) return l;
+            if (isConst(cc, l, -1)) return r;
+            if (cc->foldCanDrop && (isConst(cc, r, 0) || isConst(cc, l, 0)) && canDrop(cc, l) && canDrop(cc, r))
+                return makeConst(cc, n, 0);
+            if (cc->foldCanDrop && sameVar(cc, l, r) && canDrop(cc, l)) return l;
+            break;
+        case '|':
+            if (isConst(cc, r, 0)) return l;
+            if (isConst(cc, l, 0)) return r;
+            if (cc->foldCanDrop && (isConst(cc, r, -1) || isConst(cc, l, -1)) && canDrop(cc, l) && canDrop(cc, r))
+                return makeConst(cc, n, -1);
+            if (cc->foldCanDrop && sameVar(cc, l, r) && canDrop(cc, l)) return l;
+            break;
+        case '^':
+            if (isConst(cc, r, 0)) return l;
+            if (isConst(cc, l, 0)) return r;
+            if (cc->foldCanDrop && sameVar(cc, l, r) && canDrop(cc, l)) return makeConst(cc, n, 0);
+            break;
+    }
+    return n;
 }
 
+// Post-order on cc->evalStack; a folded node takes the place of the child
+// its parent is waiting for, the right one after the second child and the
+// only one of '='. INCDEC and the left side of ADDSUB_ASSIGN are only
+// variables and constants, walking into them changes nothing.
+static int foldNode(Compiler *cc, int root) {
+    int m = root;
 
+    cc->evalTop = 0;
+    pushEval(cc, root);
+    while (cc->evalTop > 0) {
+        EvalFrame *f = &cc->evalStack[cc->evalTop - 1];
+        int n = f->node, child = nextChild(cc, f);
+        BTNode *node;
 
-
-void err(ErrorType errorNum) {
-    if (PRINTERR) {
-        printf("EXIT 1\n");
-        
+        if (child != 0) {
+            pushEval(cc, child);
+            continue;
+        }
+        cc->evalTop--;
+        switch (cc->nodes[n].data) {
+            case INT:
+            case ID:
+            case INCDEC:
+            case ASSIGN:
+            case ADDSUB_ASSIGN:
+                m = n;
+                break;
+            default:
+                m = simplify(cc, n);
+        }
+        cc->foldDrop[m] = canDrop(cc, m);
+        if (cc->evalTop > 0) {
+            f = &cc->evalStack[cc->evalTop - 1];
+            node = &cc->nodes[f->node];
+            if (f->state == 2 || node->data == ASSIGN)
+                node->right = m;
+            else
+                node->left = m;
+        }
+    }
+    return m;
+}
+
+int foldTree(Compiler *cc, int root) {
+    if (root == 0)
+        return root;
+    if (cc->nodecount > cc->foldCap) {
+        cc->foldCap = cc->nodecap;
+        cc->foldDrop = (char*)realloc(cc->foldDrop, cc->foldCap);
+    }
+    cc->foldCanDrop = !hasDiv(cc, root);
+    return foldNode(cc, root);
+}
+
+
+/* Register cache (--cache N)
+   Up to N variables live in r0 .. r<N-1> from one statement to the next
+   and evaluation starts at r<N>. countUses() counts beforehand how often
+   every variable is read or written in the whole program (++x and x +=
+   count twice), each access takes one off. A variable that is still
+   going to be used takes a free cache register, or the one of the cached
+   variable with the fewest uses left if that has fewer than it. An
+   assignment to a cached variable only goes to its register; memory is
+   written back when it is evicted, and only x, y and z are read out at
+   the end. */
+void countUses(Compiler *cc) {
+    const char *cur = cc->srcCur;
+    TokenSet tok, prev = END;
+    int pending = -1;
+
+    while ((tok = getToken(cc)) != ENDFILE) {
+        if (tok == UNKNOWN)
+            continue;
+        if (pending >= 0)
+            cc->table[pending].uses += tok == ADDSUB_ASSIGN ? 2 : 1;
+        pending = -1;
+        if (tok == ID) {
+            int sym = intern(cc, cc->lexeme.ptr, cc->lexeme.len);
+            if (prev == INCDEC)
+                cc->table[sym].uses += 2;
+            else
+                pending = sym;
+        }
+        prev = tok;
+    }
+    if (pending >= 0)
+        cc->table[pending].uses += 1;
+    cc->srcCur = cur;
+}
+
+// The cache register of sym, making room for it if it is worth one; -1
+// if it stays in memory. *taken is set when it only now got the register.
+static int cacheReg(Compiler *cc, int sym, int *taken) {
+    Symbol *s = &cc->table[sym];
+    int r, victim = -1;
+
+    *taken = 0;
+    if (s->reg >= 0 || s->uses <= 0)
+        return s->reg;
+    for (r = 0; r < optCache; r++) {
+        int v = cc->cacheSym[r];
+        if (v < 0)
+            break;
+        if (victim < 0 || cc->table[v].uses < cc->table[cc->cacheSym[victim]].uses)
+            victim = r;
+    }
+    if (r == optCache) {
+        Symbol *old = &cc->table[cc->cacheSym[victim]];
+        if (old->uses >= s->uses)
+            return -1;
+        if (cc->cacheDirty[victim])
+            emit(cc, OP_MOV, A_MEM, old->slot * 4, A_REG, victim);
+        old->reg = -1;
+        r = victim;
+    }
+    cc->cacheSym[r] = sym;
+    cc->cacheDirty[r] = 0;
+    s->reg = r;
+    *taken = 1;
+    return r;
+}
+
+void cacheLoad(Compiler *cc, int sym, int reg) {
+    Symbol *s = &cc->table[sym];
+    int taken, r;
+
+    s->uses--;
+    r = cacheReg(cc, sym, &taken);
+    if (r < 0) {
+        emit(cc, OP_MOV, A_REG, reg, A_MEM, s->slot * 4);
+        return;
+    }
+    if (taken)
+        emit(cc, OP_MOV, A_REG, r, A_MEM, s->slot * 4);
+    emit(cc, OP_MOV, A_REG, reg, A_REG, r);
+}
+
+int cacheOperand(Compiler *cc, int sym) {
+    Symbol *s = &cc->table[sym];
+    int taken, r;
+
+    // NOTFOUND is left to getval()
+    if (!isAssigned(cc, sym))
+        return -1;
+    s->uses--;
+    r = cacheReg(cc, sym, &taken);
+    if (r < 0) {
+        s->uses++;
+        return -1;
+    }
+    if (taken)
+        emit(cc, OP_MOV, A_REG, r, A_MEM, s->slot * 4);
+    return r;
+}
+
+void cacheStore(Compiler *cc, int sym, int reg) {
+    Symbol *s = &cc->table[sym];
+    int taken, r;
+
+    s->uses--;
+    r = cacheReg(cc, sym, &taken);
+    if (r < 0) {
+        emit(cc, OP_MOV, A_MEM, s->slot * 4, A_REG, reg);
+        return;
+    }
+    emit(cc, OP_MOV, A_REG, r, A_REG, reg);
+    cc->cacheDirty[r] = 1;
+}
+
+void cacheEpilogue(Compiler *cc) {
+    int src[3], left = 3;
+
+    // x, y and z are the first three symbols
+    for (int i = 0; i < 3; i++)
+        src[i] = cc->table[i].reg;
+    while (left > 0) {
+        int moved = 0;
+        for (int i = 0; i < 3; i++) {
+            int busy = 0;
+            if (src[i] == -2)
+                continue;
+            // r<i> may only be written once no other move reads it
+            for (int j = 0; j < 3; j++)
+                busy |= j != i && src[j] == i;
+            if (busy)
+                continue;
+            if (src[i] < 0)
+                emit(cc, OP_MOV, A_REG, i, A_MEM, i * 4);
+            else if (src[i] != i)
+                emit(cc, OP_MOV, A_REG, i, A_REG, src[i]);
+            src[i] = -2;
+            left--;
+            moved = 1;
+        }
+        if (!moved) {
+            // a cycle: park one register past both the cache and r0 .. r2,
+            // where nothing else lives
+            int i = src[0] != -2 ? 0 : 1, spare = optCache > 3 ? optCache : 3;
+            emit(cc, OP_MOV, A_REG, spare, A_REG, i);
+            for (int j = 0; j < 3; j++)
+                if (src[j] == i)
+                    src[j] = spare;
+        }
     }
-    exit(0);
+    emit(cc, OP_EXIT, A_IMM, 0, A_NONE, 0);
 }
 
 
@@ -603,193 +1803,2455 @@ void err(ErrorType errorNum) {
 codeGen implementation
 ============================================================================================*/
 
-int evaluateTree(BTNode *root) {
-    int retval = 0, lv = 0, rv = 0;
-    //static int rflag=0;
-    //new_variable=0;
-    
+void pushEval(Compiler *cc, int node) {
+    EvalFrame *f;
+    if (cc->evalTop == cc->evalCap) {
+        cc->evalCap = cc->evalCap ? cc->evalCap * 2 : 64;
+        cc->evalStack = (EvalFrame*)realloc(cc->evalStack, cc->evalCap * sizeof(EvalFrame));
+    }
+    f = &cc->evalStack[cc->evalTop++];
+    f->node = node;
+    f->state = 0;
+}
 
-    if (root != NULL) {
-        switch (root->data) {
-            case ID:
-                ID_APPEAR += 1;
-                //printf("ID_APPEAR:%d\n",ID_APPEAR);
-                //printf("ID\n");
-                printf("MOV r%d ", rflag);
-                rflag+=1;
-                retval = getval(root->lexeme);
-                printf("\n");
-                break;
-            case INT:
-                //printf("INT\n");
-                retval = atoi(root->lexeme);
-                printf("MOV r%d %d\n",rflag,retval);
-                rflag += 1;
-                break;
+int nextChild(Compiler *cc, EvalFrame *f) {
+    const BTNode *node = &cc->nodes[f->node];
+    int child = 0;
+
+    if (node->data == ASSIGN)
+        child = f->state == 0 ? node->right : 0;
+    else if (node->data != INT && node->data != ID && f->state < 2)
+        child = f->state == 0 ? node->left : node->right;
+    if (child != 0)
+        f->state++;
+    return child;
+}
+
+static int evalLeaf(Compiler *cc, const BTNode *node) {
+    int retval;
+
+    if (node->data == ID) {
+        cc->ID_APPEAR += 1;
+        retval = getval(cc, node->val, cc->rflag);
+    }
+    else {
+        retval = node->val;
+        emit(cc, OP_MOV, A_REG, cc->rflag, A_IMM, retval);
+    }
+    cc->rflag += 1;
+    return retval;
+}
+
+static int isLeaf(const BTNode *node) {
+    return node->data == ID || node->data == INT;
+}
+
+// Post-order walk on cc->evalStack: a frame is looked at once before its
+// children and once after each of them, the value of a finished child
+// goes to lv or rv of its parent. INT and ID children are evaluated in
+// place rather than on a frame of their own. The stack lives in locals,
+// through cc it would be read again after every emit().
+int evaluateTree(Compiler *cc, int root) {
+    const BTNode *nodes = cc->nodes;
+    EvalFrame *stack, *f;
+    int retval = 0, top = 0, child;
+
+    if (root == 0)
+        return 0;
+    if (isLeaf(&nodes[root]))
+        return evalLeaf(cc, &nodes[root]);
+    cc->evalTop = 0;
+    pushEval(cc, root);
+    stack = cc->evalStack;
+    top = 1;
+    while (top > 0) {
+        const BTNode *node;
+        int right = -1;
+
+        f = &stack[top - 1];
+        node = &nodes[f->node];
+        switch (node->data) {
             case ASSIGN:
-                 
-                //printf("ASSIGN\n");
-                
-                rv = evaluateTree(root->right);
-                printf("MOV ");
-                
-                
-                //printf("total%d\n", rv);
-                retval = setval(root->left->lexeme, rv);
-                printf(" r%d\n",rflag-1);
-                
+                // only the right side is evaluated, its value comes back in rv
+                if (f->state == 0) {
+                    f->state = 2;
+                    child = node->right;
+                    if (!isLeaf(&nodes[child]))
+                        goto push;
+                    f->rv = evalLeaf(cc, &nodes[child]);
+                }
+                retval = setval(cc, nodes[node->left].val, f->rv, cc->rflag - 1);
                 break;
             case ADDSUB:
             case MULDIV:
-                
-                //printf("arithmatic\n");
-                lv = evaluateTree(root->left);
-                
-                rv = evaluateTree(root->right);
-                //printf("new_variable:%d\n",new_variable);
-                
-                if (strcmp(root->lexeme, "+") == 0) {
-                    retval = lv + rv;
-                    printf("ADD r%d r%d\n", rflag-2, rflag-1);
-                    rflag -= 1;
-                } else if (strcmp(root->lexeme, "-") == 0) {
-                    retval = lv - rv;
-                    printf("SUB r%d r%d\n", rflag - 2, rflag - 1);
-                    rflag -= 1;
-                } else if (strcmp(root->lexeme, "*") == 0) {
-                    retval = lv * rv;
-                    printf("MUL r%d r%d\n", rflag - 2, rflag - 1);
-                    rflag -= 1;
-                } else if (strcmp(root->lexeme, "/") == 0) {
-                    if (rv == 0) {   
-                        //printf("ID_APPEAR:%d\n",ID_APPEAR); 
-                        
-                        if (ID_APPEAR==0){
-                            err(DIVZERO);
-                        }
-                        else {
-                            printf("DIV r%d r%d\n", rflag - 2, rflag - 1);
-                            rflag -= 1;
-                            retval = 0;
-                        }
-                    }  
+            case INCDEC:
+            case AND:
+            case OR:
+            case XOR:
+            case ADDSUB_ASSIGN:
+                if (f->state == 0 && optSuperopt && superEvaluate(cc, f->node, &retval))
+                    break;
+                if (f->state == 0) {
+                    f->state = 1;
+                    child = node->left;
+                    if (!isLeaf(&nodes[child]))
+                        goto push;
+                    f->lv = evalLeaf(cc, &nodes[child]);
+                }
+                if (f->state == 1) {
+                    f->state = 2;
+                    child = node->right;
+                    if (!isLeaf(&nodes[child]))
+                        goto push;
+                    if (optCache && nodes[child].data == ID)
+                        right = cacheOperand(cc, nodes[child].val);
+                    if (right >= 0) {
+                        cc->ID_APPEAR += 1;
+                        f->rv = cc->table[nodes[child].val].val;
+                    }
                     else {
-                        printf("DIV r%d r%d\n", rflag - 2, rflag - 1);
-                        rflag -= 1;
-                        retval = lv / rv;
+                        f->rv = evalLeaf(cc, &nodes[child]);
                     }
                 }
+                if (node->val == '/' && f->rv == 0 && cc->ID_APPEAR == 0)
+                    err(cc, DIVZERO);
+                if (node->val == '/' && (f->rv == 0 || (f->lv == INT_MIN && f->rv == -1)))
+                    cc->foldTrap = 1;
+                if (right >= 0) {
+                    emitArith(cc, node->val, cc->rflag - 1, right);
+                }
+                else {
+                    emitArith(cc, node->val, cc->rflag - 2, cc->rflag - 1);
+                    cc->rflag -= 1;
+                }
+                retval = node->val == '/' && f->rv == 0 ? 0 : calc(node->val, f->lv, f->rv);
+                if (node->data == INCDEC || node->data == ADDSUB_ASSIGN)
+                    retval = setval(cc, nodes[node->left].val, retval, cc->rflag - 1);
                 break;
+            default:
+                retval = 0;
+        }
+        if (--top > 0) {
+            f = &stack[top - 1];
+            if (f->state == 1)
+                f->lv = retval;
+            else
+                f->rv = retval;
+        }
+        continue;
 
-            case INCDEC:
-                
-                //printf("INDEC\n");
-                lv = evaluateTree(root->left);
-                rv = evaluateTree(root->right);
-                
-                if (strcmp(root->lexeme, "++") == 0) {
-                    printf("ADD r%d r%d\n", rflag - 2, rflag - 1);
-                    rflag -= 1;
-                    printf("MOV ");
-                    retval = lv + rv;
-                    retval = setval(root->left->lexeme, retval);
-                    printf(" r%d\n",rflag-1);
-                }
-                else if (strcmp(root->lexeme, "--") == 0) {
-                    printf("SUB r%d r%d\n", rflag - 2, rflag - 1);
-                    rflag -= 1;
-                    printf("MOV ");
-                    retval = lv - rv;
-                    retval = setval(root->left->lexeme, retval);
-                    printf(" r%d\n",rflag-1);
+    push:
+        if (top == cc->evalCap) {
+            cc->evalCap = cc->evalCap ? cc->evalCap * 2 : 64;
+            stack = (EvalFrame*)realloc(stack, cc->evalCap * sizeof(EvalFrame));
+            cc->evalStack = stack;
+        }
+        stack[top].node = child;
+        stack[top].state = 0;
+        top++;
+    }
+    return retval;
+}
+
+// The registers in use are r<base> .. r<rflag - 1>, their values are in
+// flatRegs[0 .. rflag - base), so a node finds its operands on top
+int flatEvaluate(Compiler *cc) {
+    const unsigned char *op = cc->flatOp;
+    const int *val = cc->flatVal, *left = cc->flatLeft;
+    int *regs = cc->flatRegs, base = cc->rflag, n = cc->nodecount;
+
+    for (int i = 1; i < n; i++) {
+        int lv, rv, v, top = cc->rflag - base;
+
+        switch (op[i]) {
+            case FL_INT:
+                emit(cc, OP_MOV, A_REG, cc->rflag, A_IMM, val[i]);
+                regs[top] = val[i];
+                cc->rflag += 1;
+                break;
+            case FL_ID:
+                cc->ID_APPEAR += 1;
+                regs[top] = getval(cc, val[i], cc->rflag);
+                cc->rflag += 1;
+                break;
+            case FL_TARGET:
+                break;
+            case FL_ASSIGN:
+                regs[top - 1] = setval(cc, val[i - left[i]], regs[top - 1], cc->rflag - 1);
+                break;
+            default:
+                lv = regs[top - 2];
+                rv = regs[top - 1];
+                if (val[i] == '/' && rv == 0 && cc->ID_APPEAR == 0)
+                    err(cc, DIVZERO);
+                if (val[i] == '/' && (rv == 0 || (lv == INT_MIN && rv == -1)))
+                    cc->foldTrap = 1;
+                emitArith(cc, val[i], cc->rflag - 2, cc->rflag - 1);
+                cc->rflag -= 1;
+                v = val[i] == '/' && rv == 0 ? 0 : calc(val[i], lv, rv);
+                if (op[i] == FL_UPDATE)
+                    v = setval(cc, val[i - left[i]], v, cc->rflag - 1);
+                regs[top - 2] = v;
+                break;
+        }
+    }
+    return cc->rflag > base ? regs[cc->rflag - base - 1] : 0;
+}
+
+/* Superoptimized trees (--superopt)
+   evaluateTree() asks superEvaluate() about every operator node before
+   it walks into it, so the largest tree that superTable[] has wins. A
+   tree only qualifies when it has no side effects, no division and
+   every variable in it is assigned: the code in the table may read a
+   leaf fewer times than the tree has it, or not at all ((a ^ b) ^ a is
+   MOV r0 b), and NOTFOUND has to come from the walk that reads it.
+   ID_APPEAR still goes up by every ID of the tree. The value of the
+   tree is what its code computes, run on the values of its leaves. */
+#ifndef MINIPROJECT_NO_SUPERTABLE
+#include "superopt_table.h"
+#else
+// bench/superopt.c writes the table and must build without one; no tree has key 0
+static const SuperEntry superTable[] = { { 0, 0, { 0 } } };
+#endif
+
+const int superImm[3] = { 0, 1, -1 };
+
+static int cmpSuper(const void *key, const void *entry) {
+    unsigned k = *(const unsigned*)key, e = ((const SuperEntry*)entry)->key;
+    return k < e ? -1 : k > e;
+}
+
+static int sameLeaf(const BTNode *a, const BTNode *b) {
+    return a->data == b->data && a->val == b->val;
+}
+
+int superEvaluate(Compiler *cc, int n, int *val) {
+    const BTNode *nodes = cc->nodes;
+    // every node still to come has a leaf of its own, so SUPER_LEAVES is enough
+    int stack[SUPER_LEAVES], leaf[SUPER_INPUTS], v[SUPER_REGS];
+    int top = 0, size = 0, inputs = 0, ids = 0;
+    unsigned key = 0;
+    const SuperEntry *e;
+
+    stack[top++] = n;
+    while (top > 0) {
+        const BTNode *node = &nodes[stack[--top]];
+        int sym;
+
+        if (++size > 2 * SUPER_LEAVES - 1)
+            return 0;
+        switch (node->data) {
+            case ID:
+                if (!isAssigned(cc, node->val))
+                    return 0;
+                ids++;
+                // fall through
+            case INT:
+                if (node->data == INT && node->val == 0) {
+                    sym = SUPER_ZERO;
+                    break;
                 }
+                for (sym = 0; sym < inputs && !sameLeaf(&nodes[leaf[sym]], node); sym++)
+                    ;
+                if (sym == SUPER_INPUTS)
+                    return 0;
+                if (sym == inputs)
+                    leaf[inputs++] = node - nodes;
+                sym += SUPER_LEAF;
                 break;
-                
+            case ADDSUB:
+            case MULDIV:
             case AND:
             case OR:
             case XOR:
-                
-                //printf("logic\n");
-                lv = evaluateTree(root->left);
-                rv = evaluateTree(root->right);
-                
-                if (strcmp(root->lexeme, "&") == 0) {
-                    printf("AND r%d r%d\n", rflag - 2, rflag - 1);
-                    rflag -= 1;
-                    retval = lv & rv;
+                if (node->val == '/' || top + 2 > SUPER_LEAVES)
+                    return 0;
+                sym = (int)(strchr("?+-*/&|^", node->val) - "?+-*/&|^");
+                stack[top++] = node->right;
+                stack[top++] = node->left;
+                break;
+            default:
+                return 0;
+        }
+        key = key << 4 | sym;
+    }
+    e = (const SuperEntry*)bsearch(&key, superTable, sizeof(superTable) / sizeof(superTable[0]),
+                                   sizeof(SuperEntry), cmpSuper);
+    if (e == NULL)
+        return 0;
+
+    for (int i = 0; i < e->len; i++) {
+        int kind = e->code[i] & 15, d = e->code[i] >> 4 & 3, src = e->code[i] >> 6;
+        int r = cc->rflag + d;
+
+        if (kind == SUPER_LOAD && nodes[leaf[src]].data == ID) {
+            v[d] = getval(cc, nodes[leaf[src]].val, r);
+        }
+        else if (kind == SUPER_LOAD || kind == SUPER_IMM) {
+            v[d] = kind == SUPER_LOAD ? nodes[leaf[src]].val : superImm[src];
+            emit(cc, OP_MOV, A_REG, r, A_IMM, v[d]);
+        }
+        else if (kind == SUPER_MOVR) {
+            v[d] = v[src];
+            emit(cc, OP_MOV, A_REG, r, A_REG, cc->rflag + src);
+        }
+        else {
+            v[d] = calc("?+-*/&|^"[kind], v[d], v[src]);
+            emit(cc, (OpCode)kind, A_REG, r, A_REG, cc->rflag + src);
+        }
+    }
+    cc->ID_APPEAR += ids;
+    cc->rflag += 1;
+    *val = v[0];
+    return 1;
+}
+
+/* Sethi-Ullman code generation (--regs N)
+   suNeed[n] is how many registers n takes without spilling. Children
+   without side effects are evaluated heavier first; when the second
+   operand does not fit in the registers left, the first one is spilled
+   to a scratch slot above every variable the statement can create.
+   suIdBefore[n] tells for '/' whether evaluateTree() would have seen an
+   ID by then (ID_APPEAR). */
+static int isCommutative(int op) {
+    return op != '-' && op != '/';
+}
+
+// Label the tree in the same order evaluateTree() walks it, on the same stack
+static void suLabel(Compiler *cc, int root) {
+    cc->evalTop = 0;
+    pushEval(cc, root);
+    while (cc->evalTop > 0) {
+        EvalFrame *f = &cc->evalStack[cc->evalTop - 1];
+        int n = f->node, child = nextChild(cc, f), L, R, needA, needB;
+        BTNode *node = &cc->nodes[n];
+
+        if (child != 0) {
+            pushEval(cc, child);
+            continue;
+        }
+        cc->evalTop--;
+
+        switch (node->data) {
+            case INT:
+                cc->suNeed[n] = 1;
+                cc->suPure[n] = 1;
+                break;
+            case ID:
+                // NOTFOUND must stay where evaluateTree() has it
+                cc->suIds++;
+                cc->suNeed[n] = 1;
+                cc->suPure[n] = isAssigned(cc, node->val);
+                break;
+            case ASSIGN:
+                if (!isAssigned(cc, cc->nodes[node->left].val))
+                    cc->suScratch++;
+                cc->suNeed[n] = cc->suNeed[node->right];
+                cc->suPure[n] = 0;
+                break;
+            default:
+                cc->suIdBefore[n] = cc->suIds > 0;
+                L = cc->suNeed[node->left];
+                R = cc->suNeed[node->right];
+                needA = L > R + 1 ? L : R + 1;
+                needB = R > L + 1 ? R : L + 1;
+                cc->suPure[n] = node->data != INCDEC && node->data != ADDSUB_ASSIGN
+                    && cc->suPure[node->left] && cc->suPure[node->right];
+                cc->suNeed[n] = cc->suPure[node->left] && cc->suPure[node->right] && needB < needA ? needB : needA;
+        }
+    }
+}
+
+// Generate root into r0, using only r0 .. r<optRegs-1>. A frame generates
+// its node into r<reg>; of the children, the one evaluated first (lv)
+// goes to the same register, the second one (rv) to the next unless the
+// first is spilled to make room for it.
+static int suGen(Compiler *cc, int root) {
+    int retval = 0;
+
+    cc->evalTop = 0;
+    pushEval(cc, root);
+    cc->evalStack[0].reg = 0;
+    while (cc->evalTop > 0) {
+        EvalFrame *f = &cc->evalStack[cc->evalTop - 1];
+        BTNode *node = &cc->nodes[f->node];
+        int op = node->val, l = node->left, r = node->right, b = f->reg;
+        int avail = optRegs - b, swap = 0, spill, first, second, lv, rv, lreg;
+        int child = 0, childReg = b;
+
+        switch (node->data) {
+            case INT:
+                emit(cc, OP_MOV, A_REG, b, A_IMM, node->val);
+                retval = node->val;
+                break;
+            case ID:
+                retval = getval(cc, node->val, b);
+                break;
+            case ASSIGN:
+                if (f->state == 0) {
+                    f->state = 2;
+                    child = r;
+                }
+                else
+                    retval = setval(cc, cc->nodes[l].val, f->rv, b);
+                break;
+            default:
+                if (cc->suPure[l] && cc->suPure[r] && cc->suNeed[r] > cc->suNeed[l]) {
+                    int needA = cc->suNeed[l] > cc->suNeed[r] + 1 ? cc->suNeed[l] : cc->suNeed[r] + 1;
+                    swap = isCommutative(op) || needA > avail;
                 }
-                else if (strcmp(root->lexeme, "|") == 0) {
-                    printf("OR r%d r%d\n", rflag - 2, rflag - 1);
-                    rflag -= 1;
-                    retval = lv | rv;
+                first = swap ? r : l;
+                second = swap ? l : r;
+                spill = cc->suNeed[second] > avail - 1;
+                if (f->state == 0) {
+                    f->state = 1;
+                    child = first;
+                    break;
                 }
-                else if (strcmp(root->lexeme, "^") == 0) {
-                    printf("XOR r%d r%d\n", rflag - 2, rflag - 1);
-                    rflag -= 1;
-                    retval = lv ^ rv;
+                if (f->state == 1) {
+                    f->state = 2;
+                    child = second;
+                    if (spill)
+                        emit(cc, OP_MOV, A_MEM, (cc->suScratch + cc->suSpill++) * 4, A_REG, b);
+                    else
+                        childReg = b + 1;
+                    break;
                 }
-                
-                break;
-
+                if (spill)
+                    emit(cc, OP_MOV, A_REG, b + 1, A_MEM, (cc->suScratch + --cc->suSpill) * 4);
+                lv = swap ? f->rv : f->lv;
+                rv = swap ? f->lv : f->rv;
+                lreg = swap != spill ? b + 1 : b;
 
-            case ADDSUB_ASSIGN:
-                
-                //printf("addsubassign\n");
-                lv = evaluateTree(root->left);
-                rv = evaluateTree(root->right);
-                
-                if (strcmp(root->lexeme, "+=") == 0) {
-                    //getval(root->left->lexeme);
-                    printf("ADD r%d r%d\n", rflag - 2, rflag - 1);
-                    rflag -= 1;
-                    printf("MOV ");
-                    
-                    rv = lv + rv;
-                    //printf("\ntotal:%d\n", rv);
-                    retval = setval(root->left->lexeme, rv);
-                    printf(" r%d\n",rflag-1);
+                if (op == '/' && rv == 0 && !cc->suIdBefore[f->node])
+                    err(cc, DIVZERO);
+                if (lreg == b || isCommutative(op)) {
+                    emitArith(cc, op, b, b + 1);
                 }
-                else if (strcmp(root->lexeme, "-=") == 0) {
-                    printf("SUB r%d r%d\n", rflag - 2, rflag - 1);
-                    rflag -= 1;
-                    printf("MOV ");
-                    rv = lv - rv;
-                    //rv = rv - evaluateTree(root->right);
-                    retval = setval(root->left->lexeme, rv);
-                    printf(" r%d\n",rflag-1);
+                else {
+                    emitArith(cc, op, b + 1, b);
+                    emit(cc, OP_MOV, A_REG, b, A_REG, b + 1);
                 }
+                if (op == '/')
+                    retval = rv == 0 ? 0 : calc('/', lv, rv);
+                else
+                    retval = calc(op, lv, rv);
+
+                if (node->data == INCDEC || node->data == ADDSUB_ASSIGN)
+                    retval = setval(cc, cc->nodes[l].val, retval, b);
+        }
+        if (child != 0) {
+            pushEval(cc, child);
+            cc->evalStack[cc->evalTop - 1].reg = childReg;
+            continue;
+        }
+        if (--cc->evalTop > 0) {
+            f = &cc->evalStack[cc->evalTop - 1];
+            if (f->state == 1)
+                f->lv = retval;
+            else
+                f->rv = retval;
+        }
+    }
+    return retval;
+}
 
+int suEvaluate(Compiler *cc, int root) {
+    if (root == 0)
+        return 0;
+    if (cc->nodecount > cc->suCap) {
+        cc->suCap = cc->nodecap;
+        cc->suNeed = (int*)realloc(cc->suNeed, cc->suCap * sizeof(int));
+        cc->suPure = (char*)realloc(cc->suPure, cc->suCap);
+        cc->suIdBefore = (char*)realloc(cc->suIdBefore, cc->suCap);
+    }
+    cc->suIds = 0;
+    cc->suScratch = 0;
+    cc->suSpill = 0;
+    suLabel(cc, root);
+    cc->suScratch += cc->sbcount;
+    return suGen(cc, root);
+}
+
+/* Common subexpressions (--cse)
+   cseNumber() gives every node a value number in the order evaluateTree()
+   walks the tree. Constants and operators are hash-consed on (operator,
+   operand values); a variable takes the value last loaded from or stored
+   to it in this statement, so "=", "+=" and "++"/"--" give it a new one
+   and later reads see what was stored rather than a stale load. A node
+   is fresh when it is the first to compute its value. cseGen() then
+   walks the same way, skips pure subtrees whose value is already in a
+   register and frees a register after the last read cseNumber() counted.
+   An operation goes into the register of an operand that dies there,
+   otherwise into a copy. Stores, NOTFOUND and DIVZERO (through
+   ID_APPEAR) happen in the same order as with evaluateTree(). */
+static int cseValue(Compiler *cc, int op, int a, int b, int hashed, int *fresh) {
+    unsigned h = ((unsigned)op * 0x9E3779B1u ^ (unsigned)a * 0x85EBCA77u ^ (unsigned)b * 0xC2B2AE3Du);
+    CseValue *v;
+    int i = -1;
+
+    if (hashed) {
+        i = h & (cc->cseHashCap - 1);
+        while (cc->cseHash[i] >= 0) {
+            v = &cc->cseVals[cc->cseHash[i]];
+            if (v->op == op && v->a == a && v->b == b) {
+                *fresh = 0;
+                return cc->cseHash[i];
+            }
+            i = (i + 1) & (cc->cseHashCap - 1);
+        }
+        cc->cseHash[i] = cc->cseValCount;
+    }
+    *fresh = 1;
+    v = &cc->cseVals[cc->cseValCount];
+    v->op = op;
+    v->a = a;
+    v->b = b;
+    v->uses = 0;
+    v->reg = -1;
+    v->slot = i;
+    return cc->cseValCount++;
+}
+
+static void cseSetVar(Compiler *cc, int sym, int v) {
+    cc->cseVar[sym] = v;
+    cc->cseVarStamp[sym] = cc->cseStamp;
+}
+
+// Number the tree in the order evaluateTree() walks it, on the same stack
+static void cseNumber(Compiler *cc, int root) {
+    cc->evalTop = 0;
+    pushEval(cc, root);
+    while (cc->evalTop > 0) {
+        EvalFrame *f = &cc->evalStack[cc->evalTop - 1];
+        int n = f->node, child = nextChild(cc, f), sym, l, r, fresh = 0;
+        BTNode *node = &cc->nodes[n];
+
+        if (child != 0) {
+            pushEval(cc, child);
+            continue;
+        }
+        cc->evalTop--;
+
+        switch (node->data) {
+            case INT:
+                cc->cseVn[n] = cseValue(cc, 0, node->val, 0, 1, &fresh);
+                cc->csePure[n] = 1;
+                cc->cseIds[n] = 0;
+                cc->cseBase += 1;
+                break;
+            case ID:
+                sym = node->val;
+                if (cc->cseVarStamp[sym] == cc->cseStamp) {
+                    cc->cseVn[n] = cc->cseVar[sym];
+                }
+                else {
+                    cc->cseVn[n] = cseValue(cc, ID, sym, 0, 0, &fresh);
+                    cseSetVar(cc, sym, cc->cseVn[n]);
+                }
+                cc->csePure[n] = 1;
+                cc->cseIds[n] = 1;
+                cc->cseBase += 1;
+                break;
+            case ASSIGN:
+                cc->cseVn[n] = cc->cseVn[node->right];
+                cc->cseVals[cc->cseVn[n]].uses++;
+                cseSetVar(cc, cc->nodes[node->left].val, cc->cseVn[n]);
+                cc->csePure[n] = 0;
+                cc->cseIds[n] = cc->cseIds[node->right];
+                cc->cseBase += 1;
                 break;
+            default:
+                l = cc->cseVn[node->left];
+                r = cc->cseVn[node->right];
+                if (isCommutative(node->val) && l > r) {
+                    int t = l;
+                    l = r;
+                    r = t;
+                }
+                cc->cseVn[n] = cseValue(cc, node->val, l, r, 1, &fresh);
+                cc->csePure[n] = node->data != INCDEC && node->data != ADDSUB_ASSIGN
+                    && cc->csePure[node->left] && cc->csePure[node->right];
+                cc->cseIds[n] = cc->cseIds[node->left] + cc->cseIds[node->right];
+                cc->cseBase += 1;
+                if (fresh) {
+                    cc->cseVals[l].uses++;
+                    cc->cseVals[r].uses++;
+                }
+                if (node->data == INCDEC || node->data == ADDSUB_ASSIGN) {
+                    cc->cseVals[cc->cseVn[n]].uses++;
+                    cseSetVar(cc, cc->nodes[node->left].val, cc->cseVn[n]);
+                    cc->cseBase += 1;
+                }
+        }
+        cc->cseFresh[n] = fresh;
+    }
+}
+
+static int cseAlloc(Compiler *cc) {
+    int r = cc->cseRegLow;
+
+    while (cc->cseRegBusy[r])
+        r++;
+    cc->cseRegBusy[r] = 1;
+    cc->cseRegLow = r + 1;
+    return r;
+}
+
+// One read of v is done, give its register back after the last one
+static void cseUse(Compiler *cc, int v) {
+    CseValue *val = &cc->cseVals[v];
 
+    if (--val->uses == 0 && val->reg >= 0) {
+        cc->cseRegBusy[val->reg] = 0;
+        if (val->reg < cc->cseRegLow)
+            cc->cseRegLow = val->reg;
+        val->reg = -1;
+    }
+}
+
+// Generate the tree on the same stack as cseNumber(), a node that is
+// already in a register is skipped with all of its children
+static int cseGen(Compiler *cc, int root) {
+    cc->evalTop = 0;
+    pushEval(cc, root);
+    while (cc->evalTop > 0) {
+        EvalFrame *f = &cc->evalStack[cc->evalTop - 1];
+        int n = f->node, v = cc->cseVn[n], l, r, dest, child;
+        BTNode *node = &cc->nodes[n];
+        CseValue *lv, *rv;
+
+        if (f->state == 0 && cc->csePure[n] && !cc->cseFresh[n]) {
+            cc->ID_APPEAR += cc->cseIds[n];
+            cc->evalTop--;
+            continue;
+        }
+        if ((child = nextChild(cc, f)) != 0) {
+            pushEval(cc, child);
+            continue;
+        }
+        cc->evalTop--;
+
+        switch (node->data) {
+            case INT:
+                cc->cseVals[v].reg = cseAlloc(cc);
+                cc->cseVals[v].val = node->val;
+                emit(cc, OP_MOV, A_REG, cc->cseVals[v].reg, A_IMM, node->val);
+                continue;
+            case ID:
+                cc->ID_APPEAR += 1;
+                cc->cseVals[v].reg = cseAlloc(cc);
+                cc->cseVals[v].val = getval(cc, node->val, cc->cseVals[v].reg);
+                continue;
+            case ASSIGN:
+                setval(cc, cc->nodes[node->left].val, cc->cseVals[v].val, cc->cseVals[v].reg);
+                cseUse(cc, v);
+                continue;
             default:
-                retval = 0;
+                break;
+        }
+
+        l = cc->cseVn[node->left];
+        r = cc->cseVn[node->right];
+        if (cc->cseFresh[n]) {
+            lv = &cc->cseVals[l];
+            rv = &cc->cseVals[r];
+            if (node->val == '/' && rv->val == 0 && cc->ID_APPEAR == 0)
+                err(cc, DIVZERO);
+            if (lv->uses == (l == r ? 2 : 1)) {
+                dest = lv->reg;
+                emitArith(cc, node->val, dest, rv->reg);
+                lv->reg = -1;
+            }
+            else if (rv->uses == 1 && isCommutative(node->val)) {
+                dest = rv->reg;
+                emitArith(cc, node->val, dest, lv->reg);
+                rv->reg = -1;
+            }
+            else {
+                dest = cseAlloc(cc);
+                emit(cc, OP_MOV, A_REG, dest, A_REG, lv->reg);
+                emitArith(cc, node->val, dest, rv->reg);
+            }
+            cc->cseVals[v].val = node->val == '/' && rv->val == 0 ? 0 : calc(node->val, lv->val, rv->val);
+            cc->cseVals[v].reg = dest;
+            cseUse(cc, l);
+            cseUse(cc, r);
+        }
+        if (node->data == INCDEC || node->data == ADDSUB_ASSIGN) {
+            setval(cc, cc->nodes[node->left].val, cc->cseVals[v].val, cc->cseVals[v].reg);
+            cseUse(cc, v);
         }
     }
-    return retval;
+    return cc->cseVn[root];
+}
+
+int cseEvaluate(Compiler *cc, int root) {
+    long base = cc->cseBase;
+    int start = cc->codeCount, v;
+
+    if (root == 0)
+        return 0;
+    if (cc->nodecount > cc->cseCap) {
+        cc->cseCap = cc->nodecap;
+        cc->cseVn = (int*)realloc(cc->cseVn, cc->cseCap * sizeof(int));
+        cc->cseFresh = (char*)realloc(cc->cseFresh, cc->cseCap);
+        cc->csePure = (char*)realloc(cc->csePure, cc->cseCap);
+        cc->cseIds = (int*)realloc(cc->cseIds, cc->cseCap * sizeof(int));
+        cc->cseVals = (CseValue*)realloc(cc->cseVals, cc->cseCap * sizeof(CseValue));
+        cc->cseRegBusy = (char*)realloc(cc->cseRegBusy, optCache + cc->cseCap + 1);
+        memset(cc->cseRegBusy + cc->cseRegCap, 0, optCache + cc->cseCap + 1 - cc->cseRegCap);
+        cc->cseRegCap = optCache + cc->cseCap + 1;
+        free(cc->cseHash);
+        cc->cseHashCap = 64;
+        while (cc->cseHashCap < 2 * cc->cseCap)
+            cc->cseHashCap *= 2;
+        cc->cseHash = (int*)malloc(cc->cseHashCap * sizeof(int));
+        memset(cc->cseHash, -1, cc->cseHashCap * sizeof(int));
+    }
+    if (cc->symcount > cc->cseVarCap) {
+        cc->cseVar = (int*)realloc(cc->cseVar, cc->symcap * sizeof(int));
+        cc->cseVarStamp = (int*)realloc(cc->cseVarStamp, cc->symcap * sizeof(int));
+        memset(cc->cseVarStamp + cc->cseVarCap, 0, (cc->symcap - cc->cseVarCap) * sizeof(int));
+        cc->cseVarCap = cc->symcap;
+    }
+    cc->cseStamp++;
+    cc->cseValCount = 0;
+    // r0 .. r<optCache-1> belong to --cache
+    cc->cseRegLow = optCache;
+    cseNumber(cc, root);
+    v = cseGen(cc, root);
+    cc->cseSaved += cc->cseBase - base - (cc->codeCount - start);
+
+    // leave the tables empty for the next statement
+    for (int i = 0; i < cc->cseValCount; i++) {
+        CseValue *val = &cc->cseVals[i];
+        if (val->slot >= 0)
+            cc->cseHash[val->slot] = -1;
+        if (val->reg >= 0)
+            cc->cseRegBusy[val->reg] = 0;
+    }
+    return cc->cseVals[v].val;
+}
+
+void reportCse(const Compiler *cc) {
+    // the error message does not end its line
+    if (cc->failed && PRINTERR)
+        fputc('\n', stderr);
+    fprintf(stderr, "cse: %ld of %ld instructions saved\n", cc->cseSaved, cc->cseBase);
 }
 
-void printPrefix(BTNode *root) {
-    if (root != NULL) {
-        printf("%s ", root->lexeme);
-        printPrefix(root->left);
-        printPrefix(root->right);
+void printPrefix(Compiler *cc, int root) {
+    if (root != 0) {
+        BTNode *node = &cc->nodes[root];
+        if (node->data == INT)
+            printf("%d ", node->val);
+        else if (node->data == ID)
+            printf("%s ", cc->table[node->val].name);
+        else if (node->data == INCDEC)
+            printf("%c%c ", node->val, node->val);
+        else if (node->data == ADDSUB_ASSIGN)
+            printf("%c= ", node->val);
+        else
+            printf("%c ", node->val);
+        printPrefix(cc, node->left);
+        printPrefix(cc, node->right);
     }
 }
 
 
 /*============================================================================================
-main
+output implementation
 ============================================================================================*/
 
+static const char *opNames[] = {
+    "MOV", "ADD", "SUB", "MUL", "DIV", "AND", "OR", "XOR", "EXIT"
+};
+static const unsigned char opLens[] = { 3, 3, 3, 3, 3, 3, 2, 3, 4 };
+
+void emit(Compiler *cc, OpCode op, ArgKind ka, int a, ArgKind kb, int b) {
+    Instr *in;
+    if (cc->codeCount == cc->codeCap) {
+        cc->codeCap = cc->codeCap ? cc->codeCap * 2 : 4096;
+        cc->code = (Instr*)realloc(cc->code, cc->codeCap * sizeof(Instr));
+    }
+    in = &cc->code[cc->codeCount++];
+    if (optStats) {
+        cc->stats.ops[op]++;
+        if (ka == A_REG && a >= cc->stats.peakRflag)
+            cc->stats.peakRflag = a + 1;
+        if (kb == A_REG && b >= cc->stats.peakRflag)
+            cc->stats.peakRflag = b + 1;
+    }
+    in->op = op;
+    in->ka = ka;
+    in->kb = kb;
+    in->a = a;
+    in->b = b;
+}
+
+void emitArith(Compiler *cc, int op, int ra, int rb) {
+    OpCode oc;
+    switch (op) {
+        case '+': oc = OP_ADD; break;
+        case '-': oc = OP_SUB; break;
+        case '*': oc = OP_MUL; break;
+        case '/': oc = OP_DIV; break;
+        case '&': oc = OP_AND; break;
+        case '|': oc = OP_OR; break;
+        default: oc = OP_XOR; break;
+    }
+    emit(cc, oc, A_REG, ra, A_REG, rb);
+}
+
+/* Peephole optimizer (--peephole)
+   The forward pass remembers what each register holds, a memory slot it
+   was loaded from or stored to or a constant, and drops or shortens
+   loads of values that are already in a register. That knowledge carries
+   over from one flushed window to the next. The backward pass then drops
+   loads into registers that are overwritten before they are read. */
+
+static void growRegs(Compiler *cc, int r) {
+    if (r >= cc->regCap) {
+        int cap = cc->regCap ? cc->regCap : 16;
+        while (r >= cap)
+            cap *= 2;
+        cc->regInfo = (RegInfo*)realloc(cc->regInfo, cap * sizeof(RegInfo));
+        cc->regLive = (char*)realloc(cc->regLive, cap);
+        memset(cc->regInfo + cc->regCap, 0, (cap - cc->regCap) * sizeof(RegInfo));
+        cc->regCap = cap;
+    }
+}
+
+static void growMem(Compiler *cc, int addr) {
+    int slot = addr / 4;
+    if (slot >= cc->memCap) {
+        int cap = cc->memCap ? cc->memCap : 64;
+        while (slot >= cap)
+            cap *= 2;
+        cc->memReg = (int*)realloc(cc->memReg, cap * sizeof(int));
+        memset(cc->memReg + cc->memCap, 0, (cap - cc->memCap) * sizeof(int));
+        cc->memCap = cap;
+    }
+}
+
+static void forget(Compiler *cc, int r) {
+    RegInfo *ri = &cc->regInfo[r];
+    if (ri->kind == A_MEM && cc->memReg[ri->v / 4] == r + 1)
+        cc->memReg[ri->v / 4] = 0;
+    ri->kind = A_NONE;
+}
+
+static void remember(Compiler *cc, int r, int kind, int v) {
+    forget(cc, r);
+    cc->regInfo[r].kind = kind;
+    cc->regInfo[r].v = v;
+    if (kind == A_MEM)
+        cc->memReg[v / 4] = r + 1;
+}
+
+// A register that currently holds the value of [addr], or -1
+static int holder(Compiler *cc, int addr) {
+    int r = cc->memReg[addr / 4] - 1;
+    if (r >= 0 && cc->regInfo[r].kind == A_MEM && cc->regInfo[r].v == addr)
+        return r;
+    return -1;
+}
+
+// Returns 0 when the instruction can be dropped, it may also be rewritten
+static int peepForward(Compiler *cc, Instr *in) {
+    RegInfo *ri;
+    int h;
+
+    if (in->op == OP_EXIT)
+        return 1;
+    // only register operands are register numbers, b may be any constant
+    growRegs(cc, in->ka == A_MEM ? in->b : in->kb == A_REG && in->b > in->a ? in->b : in->a);
+    if (in->ka == A_MEM || in->kb == A_MEM)
+        growMem(cc, in->ka == A_MEM ? in->a : in->b);
+    ri = &cc->regInfo[in->a];
+
+    if (in->op != OP_MOV) {
+        forget(cc, in->a);
+        return 1;
+    }
+    if (in->ka == A_MEM) {
+        // the register was loaded from or stored to this slot, nothing changed since
+        if (cc->regInfo[in->b].kind == A_MEM && cc->regInfo[in->b].v == in->a)
+            return 0;
+        for (h = 0; h < cc->regCap; h++)
+            if (cc->regInfo[h].kind == A_MEM && cc->regInfo[h].v == in->a)
+                forget(cc, h);
+        remember(cc, in->b, A_MEM, in->a);
+        return 1;
+    }
+    if (in->kb == A_MEM) {
+        int addr = in->b;
+        if (ri->kind == A_MEM && ri->v == addr)
+            return 0;
+        h = holder(cc, addr);
+        if (h >= 0) {
+            in->kb = A_REG;
+            in->b = h;
+        }
+        remember(cc, in->a, A_MEM, addr);
+        return 1;
+    }
+    if (in->kb == A_IMM) {
+        if (ri->kind == A_IMM && ri->v == in->b)
+            return 0;
+        remember(cc, in->a, A_IMM, in->b);
+        return 1;
+    }
+    // MOV rJ rK
+    if (in->a == in->b)
+        return 0;
+    if (ri->kind != A_NONE && ri->kind == cc->regInfo[in->b].kind && ri->v == cc->regInfo[in->b].v)
+        return 0;
+    if (cc->regInfo[in->b].kind == A_NONE)
+        forget(cc, in->a);
+    else
+        remember(cc, in->a, cc->regInfo[in->b].kind, cc->regInfo[in->b].v);
+    return 1;
+}
+
+void peephole(Compiler *cc) {
+    int i, n = 0, exit0;
 
+    for (i = 0; i < cc->codeCount; i++)
+        if (peepForward(cc, &cc->code[i]))
+            cc->code[n++] = cc->code[i];
+    cc->codeCount = n;
+    if (n == 0)
+        return;
 
-int main() {
-    initTable();
-    //printf(">> ");
-    while (1) {
-        rflag=0;
-        ID_APPEAR = 0;
-        statement();
+    // after EXIT 0 only r0..r2 are looked at, otherwise keep every register alive
+    exit0 = cc->code[n - 1].op == OP_EXIT && cc->code[n - 1].a == 0;
+    memset(cc->regLive, !exit0, cc->regCap);
+    if (exit0)
+        cc->regLive[0] = cc->regLive[1] = cc->regLive[2] = 1;
+    for (i = n - 1; i >= 0; i--) {
+        Instr *in = &cc->code[i];
+        if (in->op == OP_EXIT)
+            continue;
+        if (in->op != OP_MOV) {
+            cc->regLive[in->a] = cc->regLive[in->b] = 1;
+        }
+        else if (in->ka == A_MEM) {
+            cc->regLive[in->b] = 1;
+        }
+        else if (!cc->regLive[in->a]) {
+            in->op = OP_EXIT;
+            in->kb = A_NONE;
+            in->a = -1;
+        }
+        else {
+            cc->regLive[in->a] = 0;
+            if (in->kb == A_REG)
+                cc->regLive[in->b] = 1;
+        }
+    }
+    for (i = n = 0; i < cc->codeCount; i++)
+        if (cc->code[i].op != OP_EXIT || cc->code[i].a >= 0)
+            cc->code[n++] = cc->code[i];
+    cc->codeCount = n;
+}
+
+
+/* Dead code elimination (--dse)
+   The whole program is kept in the buffer and goes through this pass
+   once. What a program shows is r0 .. r2 at EXIT 0, or only its status
+   at EXIT 1, and a division the machine may trap on: by zero, or
+   INT_MIN / -1 (the cases foldTree() leaves alone too). All values are
+   known, so a forward run finds those divisions; a backward pass then
+   keeps what they and the EXIT read, following registers and memory
+   slots, and drops every other instruction. */
+void eliminateDead(Compiler *cc) {
+    int n = cc->codeCount, regs = 3, slots = 1, i, k;
+    int *rv, *mv;
+    char *liveR, *liveM, *trap;
+    const Instr *last = n > 0 ? &cc->code[n - 1] : NULL;
+
+    if (last == NULL || last->op != OP_EXIT)
+        return;
+    for (i = 0; i < n - 1; i++) {
+        const Instr *in = &cc->code[i];
+        if (in->op == OP_EXIT)
+            return;
+        if (in->ka == A_REG && in->a >= regs)
+            regs = in->a + 1;
+        if (in->kb == A_REG && in->b >= regs)
+            regs = in->b + 1;
+        if (in->ka == A_MEM && in->a / 4 >= slots)
+            slots = in->a / 4 + 1;
+        if (in->kb == A_MEM && in->b / 4 >= slots)
+            slots = in->b / 4 + 1;
+    }
+    rv = (int*)calloc(regs, sizeof(int));
+    mv = (int*)calloc(slots, sizeof(int));
+    liveR = (char*)calloc(regs, 1);
+    liveM = (char*)calloc(slots, 1);
+    trap = (char*)calloc(n, 1);
+
+    // run the program like vmRun()
+    for (i = 0; i < n - 1; i++) {
+        const Instr *in = &cc->code[i];
+        int b = in->kb == A_REG ? rv[in->b] : in->kb == A_MEM ? mv[in->b / 4] : in->b;
+        if (in->op == OP_MOV) {
+            if (in->ka == A_MEM)
+                mv[in->a / 4] = b;
+            else
+                rv[in->a] = b;
+            continue;
+        }
+        if (in->op == OP_DIV)
+            trap[i] = b == 0 || (b == -1 && rv[in->a] == INT_MIN);
+        rv[in->a] = in->op == OP_DIV && b == 0 ? 0 : calc("?+-*/&|^"[in->op], rv[in->a], b);
+    }
+
+    if (last->a == 0)
+        liveR[0] = liveR[1] = liveR[2] = 1;
+    for (i = n - 2; i >= 0; i--) {
+        Instr *in = &cc->code[i];
+        int keep;
+        if (in->op != OP_MOV) {
+            keep = trap[i] || liveR[in->a];
+            if (keep)
+                liveR[in->a] = liveR[in->b] = 1;
+        }
+        else if (in->ka == A_MEM) {
+            keep = liveM[in->a / 4];
+            liveM[in->a / 4] = 0;
+            if (keep)
+                liveR[in->b] = 1;
+        }
+        else {
+            keep = liveR[in->a];
+            liveR[in->a] = 0;
+            if (keep && in->kb == A_REG)
+                liveR[in->b] = 1;
+            else if (keep && in->kb == A_MEM)
+                liveM[in->b / 4] = 1;
+        }
+        if (!keep)
+            in->op = OP_EXIT;
+    }
+    for (i = k = 0; i < n - 1; i++)
+        if (cc->code[i].op != OP_EXIT)
+            cc->code[k++] = cc->code[i];
+    cc->code[k++] = *last;
+    cc->codeCount = k;
+
+    free(rv);
+    free(mv);
+    free(liveR);
+    free(liveM);
+    free(trap);
+}
+
+static const char digitPairs[] =
+    "00010203040506070809" "10111213141516171819" "20212223242526272829"
+    "30313233343536373839" "40414243444546474849" "50515253545556575859"
+    "60616263646566676869" "70717273747576777879" "80818283848586878889"
+    "90919293949596979899";
+
+// Same text as printf("%d")
+static char *formatInt(char *p, int v) {
+    char tmp[12];
+    char *t = tmp + sizeof(tmp);
+    unsigned u = v < 0 ? 0u - (unsigned)v : (unsigned)v;
+
+    while (u >= 100) {
+        unsigned q = u / 100;
+        t -= 2;
+        memcpy(t, digitPairs + (u - q * 100) * 2, 2);
+        u = q;
+    }
+    if (u >= 10) {
+        t -= 2;
+        memcpy(t, digitPairs + u * 2, 2);
+    }
+    else {
+        *--t = '0' + u;
+    }
+    if (v < 0)
+        *--t = '-';
+    memcpy(p, t, tmp + sizeof(tmp) - t);
+    return p + (tmp + sizeof(tmp) - t);
+}
+
+static char *formatArg(char *p, ArgKind k, int v) {
+    if (k == A_REG) {
+        *p++ = 'r';
+        return formatInt(p, v);
+    }
+    if (k == A_MEM) {
+        *p++ = '[';
+        p = formatInt(p, v);
+        *p++ = ']';
+        return p;
+    }
+    return formatInt(p, v);
+}
+
+char *formatInstr(char *p, const Instr *in) {
+    if (in->op == OP_EXIT) {
+        if (in->kb == A_REG) {
+            memcpy(p, "MOV r", 5);
+            p = formatInt(p + 5, in->b);
+            *p++ = ' ';
+        }
+        memcpy(p, "EXIT ", 5);
+        p = formatInt(p + 5, in->a);
+    }
+    else {
+        size_t n = opLens[in->op];
+        memcpy(p, opNames[in->op], n);
+        p[n] = ' ';
+        p = formatArg(p + n + 1, in->ka, in->a);
+        *p++ = ' ';
+        p = formatArg(p, in->kb, in->b);
+    }
+    *p++ = '\n';
+    return p;
+}
+
+static char *putLE(char *p, unsigned v, int bytes) {
+    for (int i = 0; i < bytes; i++, v >>= 8)
+        *p++ = (char)(v & 0xff);
+    return p;
+}
+
+static unsigned getLE(const unsigned char *p, int bytes) {
+    unsigned v = 0;
+    for (int i = bytes - 1; i >= 0; i--)
+        v = v << 8 | p[i];
+    return v;
+}
+
+char *encodeInstr(char *p, const Instr *in) {
+    unsigned a = in->ka == A_MEM ? in->a / 4 : in->a;
+    int b = in->kb == A_MEM ? in->b / 4 : in->b;
+
+    putLE(p, in->op | in->ka << 4 | in->kb << 6 | a << 8, 4);
+    putLE(p + 4, (unsigned)b, 4);
+    return p + BIN_RECORD;
+}
+
+static void writeAll(int fd, const char *p, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n = write(fd, p + done, len - done);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        done += n;
+    }
+}
+
+void flushOutput(Compiler *cc) {
+    if (cc->outFd < 0 || optBinary) {
+        // keep the text, it is picked up from outBuf later (by
+        // writeBinary(), which needs the count of records first)
+        if (cc->outCap - cc->outLen < OUTBUF_SIZE) {
+            cc->outCap *= 2;
+            cc->outBuf = (char*)realloc(cc->outBuf, cc->outCap);
+        }
+        return;
+    }
+    writeAll(cc->outFd, cc->outBuf, cc->outLen);
+    cc->outLen = 0;
+}
+
+// The highest slot a record touches, for the header of --emit=binary,
+// and a check that every a fits in its 24 bits
+static void countSlots(Compiler *cc) {
+    for (int i = 0; i < cc->codeCount; i++) {
+        const Instr *in = &cc->code[i];
+        int addr = in->ka == A_MEM ? in->a : in->kb == A_MEM ? in->b : -1;
+        if (addr / 4 >= cc->binSlots)
+            cc->binSlots = addr / 4 + 1;
+        if ((in->ka == A_MEM ? in->a / 4 : in->a) >= 1 << 24) {
+            fprintf(stderr, "--emit=binary: operand %d does not fit in a record\n", in->a);
+            exit(1);
+        }
+    }
+}
+
+void writeBinary(Compiler *cc) {
+    char header[BIN_HEADER], *p = header;
+
+    memcpy(p, "MPBC", 4);
+    p = putLE(p + 4, BIN_VERSION, 2);
+    p = putLE(p, BIN_RECORD, 2);
+    p = putLE(p, cc->binSlots > 3 ? cc->binSlots : 3, 4);
+    putLE(p, (unsigned)(cc->outLen / BIN_RECORD), 4);
+    writeAll(cc->outFd, header, BIN_HEADER);
+    writeAll(cc->outFd, cc->outBuf, cc->outLen);
+    cc->outLen = 0;
+}
+
+int disassemble(Compiler *cc) {
+    const unsigned char *p = (const unsigned char*)cc->srcBegin;
+    size_t size = cc->srcEnd - cc->srcBegin;
+    unsigned count;
+
+    if (size < BIN_HEADER || memcmp(p, "MPBC", 4) != 0 || getLE(p + 4, 2) != BIN_VERSION
+        || getLE(p + 6, 2) != BIN_RECORD) {
+        fprintf(stderr, "not a binary program\n");
+        return 1;
+    }
+    count = getLE(p + 12, 4);
+    if ((size - BIN_HEADER) / BIN_RECORD < count) {
+        fprintf(stderr, "binary program cut short\n");
+        return 1;
+    }
+    for (p += BIN_HEADER; count > 0; count--, p += BIN_RECORD) {
+        Instr in;
+        unsigned w = getLE(p, 4);
+        in.op = w & 15;
+        in.ka = w >> 4 & 3;
+        in.kb = w >> 6 & 3;
+        in.a = (int)(w >> 8) * (in.ka == A_MEM ? 4 : 1);
+        in.b = (int)getLE(p + 4, 4) * (in.kb == A_MEM ? 4 : 1);
+        if (in.op > OP_EXIT) {
+            fprintf(stderr, "bad record in binary program\n");
+            return 1;
+        }
+        if (cc->outLen > cc->outCap - 64)
+            flushOutput(cc);
+        cc->outLen = formatInstr(cc->outBuf + cc->outLen, &in) - cc->outBuf;
+    }
+    flushOutput(cc);
+    return 0;
+}
+
+void flushCode(Compiler *cc) {
+    unsigned long long t0 = optStats ? statTicks() : 0;
+
+    if (optDse)
+        eliminateDead(cc);
+    if (optPeephole && !optJit)
+        peephole(cc);
+    if (optRun) {
+        vmAssemble(cc, cc->code, cc->codeCount);
+    }
+    else if (!optJit) {
+        if (optBinary)
+            countSlots(cc);
+        for (int i = 0; i < cc->codeCount; i++) {
+            // the longest instruction is well under 64 bytes
+            if (cc->outLen > cc->outCap - 64)
+                flushOutput(cc);
+            if (optBinary)
+                cc->outLen = encodeInstr(cc->outBuf + cc->outLen, &cc->code[i]) - cc->outBuf;
+            else
+                cc->outLen = formatInstr(cc->outBuf + cc->outLen, &cc->code[i]) - cc->outBuf;
+        }
+    }
+    cc->codeCount = 0;
+    if (optStats)
+        cc->stats.ticks[PH_OUTPUT] += statTicks() - t0;
+}
+
+void finish(Compiler *cc) {
+    unsigned long long t0;
+
+    flushCode(cc);
+    if (optRun)
+        runProgram(cc);
+    if (optJit)
+        jitRun(cc);
+    t0 = optStats ? statTicks() : 0;
+    if (optBinary)
+        writeBinary(cc);
+    else
+        flushOutput(cc);
+    if (optStats)
+        cc->stats.ticks[PH_OUTPUT] += statTicks() - t0;
+}
+
+
+/*============================================================================================
+vm implementation
+============================================================================================*/
+
+void vmAssemble(Compiler *cc, const Instr *in, int n) {
+    for (int i = 0; i < n; i++, in++) {
+        VmInstr *vi;
+        if (cc->vmCount == cc->vmCap) {
+            cc->vmCap = cc->vmCap ? cc->vmCap * 2 : 4096;
+            cc->vmCode = (VmInstr*)realloc(cc->vmCode, cc->vmCap * sizeof(VmInstr));
+        }
+        vi = &cc->vmCode[cc->vmCount++];
+        vi->a = in->a;
+        vi->b = in->b;
+        switch (in->op) {
+            case OP_MOV:
+                if (in->ka == A_MEM) {
+                    vi->u.op = VM_STORE;
+                    vi->a = in->a / 4;
+                }
+                else if (in->kb == A_MEM) {
+                    vi->u.op = VM_LOAD;
+                    vi->b = in->b / 4;
+                }
+                else {
+                    vi->u.op = in->kb == A_IMM ? VM_LOADI : VM_MOVR;
+                }
+                break;
+            case OP_EXIT:
+                vi->u.op = VM_EXIT;
+                continue;
+            default:
+                vi->u.op = VM_ADD + (in->op - OP_ADD);
+                break;
+        }
+        if (in->ka == A_REG && in->a >= cc->vmRegs)
+            cc->vmRegs = in->a + 1;
+        if (in->kb == A_REG && in->b >= cc->vmRegs)
+            cc->vmRegs = in->b + 1;
+        if (vi->u.op == VM_STORE && vi->a >= cc->vmSlots)
+            cc->vmSlots = vi->a + 1;
+        if (vi->u.op == VM_LOAD && vi->b >= cc->vmSlots)
+            cc->vmSlots = vi->b + 1;
+    }
+}
+
+// Direct-threaded interpreter: every instruction jumps straight to the next handler
+int vmRun(Compiler *cc, int *regs) {
+    static const void *handlers[] = {
+        &&loadi, &&load, &&store, &&movr,
+        &&add, &&sub, &&mul, &&div, &&and, &&or, &&xor,
+        &&exit
+    };
+    int *r, *mem, status;
+    VmInstr *ip;
+
+    // a program cut short by an error without PRINTERR has no EXIT
+    if (cc->vmCount == 0 || cc->vmCode[cc->vmCount - 1].u.op != VM_EXIT) {
+        vmAssemble(cc, &(Instr){ OP_EXIT, A_IMM, A_NONE, 1, 0 }, 1);
+    }
+    for (int i = 0; i < cc->vmCount; i++)
+        cc->vmCode[i].u.h = handlers[cc->vmCode[i].u.op];
+    r = (int*)calloc(cc->vmRegs, sizeof(int));
+    mem = (int*)calloc(cc->vmSlots, sizeof(int));
+    ip = cc->vmCode;
+
+#define NEXT() do { ip++; goto *ip->u.h; } while (0)
+    goto *ip->u.h;
+loadi:
+    r[ip->a] = ip->b;
+    NEXT();
+load:
+    r[ip->a] = mem[ip->b];
+    NEXT();
+store:
+    mem[ip->a] = r[ip->b];
+    NEXT();
+movr:
+    r[ip->a] = r[ip->b];
+    NEXT();
+add:
+    r[ip->a] = (int)((unsigned)r[ip->a] + (unsigned)r[ip->b]);
+    NEXT();
+sub:
+    r[ip->a] = (int)((unsigned)r[ip->a] - (unsigned)r[ip->b]);
+    NEXT();
+mul:
+    r[ip->a] = (int)((unsigned)r[ip->a] * (unsigned)r[ip->b]);
+    NEXT();
+div:
+    // dividing by zero gives 0 like evaluateTree(), INT_MIN / -1 wraps
+    if (r[ip->b] == 0)
+        r[ip->a] = 0;
+    else if (r[ip->b] == -1)
+        r[ip->a] = (int)(0u - (unsigned)r[ip->a]);
+    else
+        r[ip->a] /= r[ip->b];
+    NEXT();
+and:
+    r[ip->a] &= r[ip->b];
+    NEXT();
+or:
+    r[ip->a] |= r[ip->b];
+    NEXT();
+xor:
+    r[ip->a] ^= r[ip->b];
+    NEXT();
+exit:
+#undef NEXT
+    status = ip->a;
+    for (int i = 0; i < 3; i++)
+        regs[i] = r[i];
+    free(r);
+    free(mem);
+    return status;
+}
+
+void runProgram(Compiler *cc) {
+    int regs[3];
+    int status = vmRun(cc, regs);
+
+    if (status != 0) {
+        printf("EXIT %d\n", status);
+        return;
+    }
+    checkResult(cc, "--run", regs);
+}
+
+void checkResult(Compiler *cc, const char *mode, const int *xyz) {
+    printf("x = %d, y = %d, z = %d\n", xyz[0], xyz[1], xyz[2]);
+    for (int i = 0; i < 3; i++) {
+        if (xyz[i] != cc->table[i].val) {
+            fprintf(stderr, "%s: %s = %d but %d at compile time\n",
+                    mode, cc->table[i].name, xyz[i], cc->table[i].val);
+            fflush(stdout);
+            exit(1);
+        }
+    }
+}
+
+
+/*============================================================================================
+jit implementation
+============================================================================================*/
+
+/* x86-64 backend (--jit)
+   Every statement is lowered to native code appended to one buffer that
+   becomes `void program(int32_t *slots, int32_t *spill)`. rdi keeps the
+   slot array, the value of an expression is computed in eax, and the left
+   operand of a binary operator waits on the machine stack while the right
+   one is computed. Past JIT_PUSH_MAX waiting operands the deeper ones go
+   to the spill array in rsi instead, so that no statement can run the
+   native stack out. Only eax, ecx and edx are touched, so no prologue is
+   needed. */
+
+// Operands kept on the machine stack at most, 8 KB of it
+#define JIT_PUSH_MAX 1024
+
+static void jitBytes(Compiler *cc, const unsigned char *b, size_t n) {
+    if (cc->jitLen + n > cc->jitCap) {
+        size_t cap = cc->jitCap ? cc->jitCap * 2 : 1 << 16;
+        unsigned char *buf;
+        while (cc->jitLen + n > cap)
+            cap *= 2;
+        buf = mmap(NULL, cap, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buf == MAP_FAILED) {
+            perror("--jit");
+            exit(1);
+        }
+        if (cc->jitBuf != NULL) {
+            memcpy(buf, cc->jitBuf, cc->jitLen);
+            munmap(cc->jitBuf, cc->jitCap);
+        }
+        cc->jitBuf = buf;
+        cc->jitCap = cap;
+    }
+    memcpy(cc->jitBuf + cc->jitLen, b, n);
+    cc->jitLen += n;
+}
+
+// op eax, [rdi + disp32] style instructions: opcode, ModRM 10 000 111, disp32
+static void jitSlot(Compiler *cc, unsigned char opcode, int slot) {
+    unsigned char b[6] = { opcode, 0x87 };
+    int disp = slot * 4;
+    memcpy(b + 2, &disp, 4);
+    jitBytes(cc, b, 6);
+}
+
+// Keep eax, the left operand, while the right one is computed
+static void jitSave(Compiler *cc) {
+    unsigned char b[6] = { 0x89, 0x86 };                        // mov [rsi + disp32], eax
+    int disp = (cc->jitDepth - JIT_PUSH_MAX) * 4;
+
+    if (cc->jitDepth++ < JIT_PUSH_MAX) {
+        jitBytes(cc, (const unsigned char *)"\x50", 1);         // push rax
+        return;
+    }
+    memcpy(b + 2, &disp, 4);
+    jitBytes(cc, b, 6);
+    if (cc->jitDepth - JIT_PUSH_MAX > cc->jitSpill)
+        cc->jitSpill = cc->jitDepth - JIT_PUSH_MAX;
+}
+
+// Right operand to ecx, the left one jitSave() kept back to eax
+static void jitRestore(Compiler *cc) {
+    unsigned char b[8] = { 0x89, 0xC1, 0x8B, 0x86 };            // mov ecx, eax; mov eax, [rsi + disp32]
+    int disp;
+
+    if (--cc->jitDepth < JIT_PUSH_MAX) {
+        jitBytes(cc, (const unsigned char *)"\x89\xC1\x58", 3); // mov ecx, eax; pop rax
+        return;
+    }
+    disp = (cc->jitDepth - JIT_PUSH_MAX) * 4;
+    memcpy(b + 4, &disp, 4);
+    jitBytes(cc, b, 8);
+}
+
+// Code for node n once its children are in place: a leaf loads eax, an
+// operator takes its left operand back and combines it with eax
+static void jitNode(Compiler *cc, int n) {
+    BTNode *node = &cc->nodes[n];
+    unsigned char b[24];
+
+    switch (node->data) {
+        case INT:
+            b[0] = 0xB8;                                    // mov eax, imm32
+            memcpy(b + 1, &node->val, 4);
+            jitBytes(cc, b, 5);
+            return;
+        case ID:
+            jitSlot(cc, 0x8B, cc->table[node->val].slot);           // mov eax, [rdi + slot*4]
+            return;
+        case ASSIGN:
+            jitSlot(cc, 0x89, cc->table[cc->nodes[node->left].val].slot);   // mov [rdi + slot*4], eax
+            return;
+        default:
+            break;
+    }
+
+    jitRestore(cc);
+    switch (node->val) {
+        case '+': jitBytes(cc, (const unsigned char *)"\x01\xC8", 2); break;       // add eax, ecx
+        case '-': jitBytes(cc, (const unsigned char *)"\x29\xC8", 2); break;       // sub eax, ecx
+        case '*': jitBytes(cc, (const unsigned char *)"\x0F\xAF\xC1", 3); break;   // imul eax, ecx
+        case '&': jitBytes(cc, (const unsigned char *)"\x21\xC8", 2); break;       // and eax, ecx
+        case '|': jitBytes(cc, (const unsigned char *)"\x09\xC8", 2); break;       // or eax, ecx
+        case '^': jitBytes(cc, (const unsigned char *)"\x31\xC8", 2); break;       // xor eax, ecx
+        case '/':
+            // x / 0 is 0 and x / -1 is a wrapping negation, like evaluateTree() and the VM
+            jitBytes(cc, (const unsigned char *)
+                     "\x85\xC9"         // test ecx, ecx
+                     "\x74\x0E"         // jz zero
+                     "\x83\xF9\xFF"     // cmp ecx, -1
+                     "\x74\x05"         // je neg
+                     "\x99"             // cdq
+                     "\xF7\xF9"         // idiv ecx
+                     "\xEB\x06"         // jmp done
+                     "\xF7\xD8"         // neg: neg eax
+                     "\xEB\x02"         // jmp done
+                     "\x31\xC0",        // zero: xor eax, eax
+                     20);
+            break;
+    }
+    if (node->data == INCDEC || node->data == ADDSUB_ASSIGN)
+        jitSlot(cc, 0x89, cc->table[cc->nodes[node->left].val].slot);
+}
+
+// Post-order on cc->evalStack, the left operand saved before the right
+// one is computed
+void jitStatement(Compiler *cc, int root) {
+    if (root == 0)
+        return;
+    cc->evalTop = 0;
+    pushEval(cc, root);
+    while (cc->evalTop > 0) {
+        EvalFrame *f = &cc->evalStack[cc->evalTop - 1];
+        int child = nextChild(cc, f);
+
+        if (child != 0) {
+            if (f->state == 2)
+                jitSave(cc);
+            pushEval(cc, child);
+            continue;
+        }
+        jitNode(cc, f->node);
+        cc->evalTop--;
+    }
+}
+
+void jitRun(Compiler *cc) {
+    void (*program)(int *, int *);
+    int *slots, *spill;
+
+    if (cc->failed) {
+        printf("EXIT 1\n");
+        return;
+    }
+    jitBytes(cc, (const unsigned char *)"\xC3", 1);             // ret
+    if (mprotect(cc->jitBuf, cc->jitCap, PROT_READ | PROT_EXEC) != 0) {
+        perror("--jit");
+        exit(1);
+    }
+    slots = (int*)calloc(cc->sbcount > 3 ? cc->sbcount : 3, sizeof(int));
+    spill = (int*)malloc((cc->jitSpill > 0 ? cc->jitSpill : 1) * sizeof(int));
+    program = (void (*)(int *, int *))(void *)cc->jitBuf;
+    program(slots, spill);
+    checkResult(cc, "--jit", slots);
+    free(slots);
+    free(spill);
+}
+
+
+/*============================================================================================
+compiler context implementation
+============================================================================================*/
+
+Compiler *newCompiler(const Compiler *resolve) {
+    Compiler *cc = (Compiler*)calloc(1, sizeof(Compiler));
+
+    if (lexScan < 0)
+        pickScan();
+    cc->resolve = resolve;
+    cc->nodecount = 1;
+    cc->tornLoad = -1;
+    cc->outCap = OUTBUF_SIZE;
+    cc->outBuf = (char*)malloc(cc->outCap);
+    cc->outFd = 1;
+    cc->epilogue = 1;
+    cc->vmRegs = 3;
+    cc->vmSlots = 3;
+    if (optCache) {
+        cc->cacheSym = (int*)malloc(optCache * sizeof(int));
+        cc->cacheDirty = (char*)calloc(optCache, 1);
+        memset(cc->cacheSym, -1, optCache * sizeof(int));
+    }
+    initTable(cc);
+    return cc;
+}
+
+void freeCompiler(Compiler *cc) {
+    void *pool = cc->namePools;
+
+    while (pool != NULL) {
+        void *prev = *(void**)pool;
+        free(pool);
+        pool = prev;
+    }
+    free(cc->table);
+    free(cc->symHash);
+    free(cc->nodes);
+    free(cc->flatOp);
+    free(cc->flatVal);
+    free(cc->flatLeft);
+    free(cc->flatRegs);
+    free(cc->ops);
+    free(cc->operands);
+    free(cc->evalStack);
+    free(cc->suNeed);
+    free(cc->suPure);
+    free(cc->foldDrop);
+    free(cc->suIdBefore);
+    free(cc->cseVn);
+    free(cc->cseFresh);
+    free(cc->csePure);
+    free(cc->cseIds);
+    free(cc->cseVals);
+    free(cc->cseHash);
+    free(cc->cseVar);
+    free(cc->cseVarStamp);
+    free(cc->cseRegBusy);
+    free(cc->cacheSym);
+    free(cc->cacheDirty);
+    free(cc->code);
+    free(cc->regInfo);
+    free(cc->memReg);
+    free(cc->regLive);
+    free(cc->outBuf);
+    free(cc->vmCode);
+    free(cc->assigns);
+    if (cc->jitBuf != NULL)
+        munmap(cc->jitBuf, cc->jitCap);
+    free(cc);
+}
+
+int compile(Compiler *cc) {
+    jmp_buf onError;
+    unsigned long long t0, other;
+    int more;
+
+    cc->onError = &onError;
+    if (setjmp(onError) == 0) {
+        do {
+            cc->rflag = optCache;
+            cc->ID_APPEAR = 0;
+            if (!optStats) {
+                more = statement(cc);
+                continue;
+            }
+            pollStats(cc);
+            // what is not code generation or output is lexing and parsing
+            t0 = statTicks();
+            other = cc->stats.ticks[PH_CODEGEN] + cc->stats.ticks[PH_OUTPUT];
+            more = statement(cc);
+            cc->stats.ticks[PH_PARSE] += statTicks() - t0
+                - (cc->stats.ticks[PH_CODEGEN] + cc->stats.ticks[PH_OUTPUT] - other);
+        } while (more);
+    }
+    cc->onError = NULL;
+    return cc->failed;
+}
+
+
+/*============================================================================================
+jobs implementation
+============================================================================================*/
+
+/* Parallel compilation (-j N)
+   The input is cut into chunks at line ends and handled a wave of chunks
+   at a time. Slots are numbered in the order variables are first
+   assigned, which depends on every earlier statement, so a wave takes
+   three steps:
+   1. every chunk is parsed on its own (scanOnly) and lists the variables
+      it assigns, in the order evaluateTree() would assign them;
+   2. the lists are replayed in source order into the table of the main
+      context, which gives every variable its final slot and every chunk
+      the sbcount it starts with;
+   3. every chunk is parsed again and compiled into its own text buffer,
+      taking slots from the main context (resolve). isAssigned() compares
+      a slot with sbcount, so NOTFOUND and the scratch slots of --regs
+      come out as in a sequential run.
+   The buffers are written in source order, up to and including the first
+   chunk that stopped at an error. With --peephole the pass starts afresh
+   in every chunk, which only costs a few redundant loads at the seams. */
+#define CHUNK_SIZE (256 << 10)
+
+typedef struct {
+    const char *begin;
+    const char *end;
+    // sbcount of a sequential run when the chunk starts
+    int sbBase;
+    Compiler *scan;
+    Compiler *gen;
+} Chunk;
+
+typedef struct {
+    Chunk *chunks;
+    int count;
+    int next;
+    int scan;
+    // index of the chunk that ends the input, -1 if it is in a later wave
+    int last;
+    const Compiler *master;
+} Wave;
+
+static void listAssign(Compiler *cc, int sym) {
+    // slot only marks the names already listed, the real ones come from step 2
+    if (cc->table[sym].slot >= 0)
+        return;
+    cc->table[sym].slot = 0;
+    if (cc->assignCount == cc->assignCap) {
+        cc->assignCap = cc->assignCap ? cc->assignCap * 2 : 256;
+        cc->assigns = (int*)realloc(cc->assigns, cc->assignCap * sizeof(int));
+    }
+    cc->assigns[cc->assignCount++] = sym;
+}
+
+// The same walk as evaluateTree(), on the same stack
+void scanAssigns(Compiler *cc, int root) {
+    cc->evalTop = 0;
+    pushEval(cc, root);
+    while (cc->evalTop > 0) {
+        EvalFrame *f = &cc->evalStack[cc->evalTop - 1];
+        BTNode *node = &cc->nodes[f->node];
+        int child = nextChild(cc, f);
+
+        if (child != 0) {
+            pushEval(cc, child);
+            continue;
+        }
+        if (node->data == ASSIGN || node->data == INCDEC || node->data == ADDSUB_ASSIGN)
+            listAssign(cc, cc->nodes[node->left].val);
+        cc->evalTop--;
+    }
+}
+
+static void *jobWorker(void *arg) {
+    Wave *w = (Wave*)arg;
+    int i;
+
+    while ((i = __atomic_fetch_add(&w->next, 1, __ATOMIC_RELAXED)) < w->count) {
+        Chunk *ch = &w->chunks[i];
+        Compiler *cc = newCompiler(w->scan ? NULL : w->master);
+
+        cc->srcBegin = ch->begin;
+        cc->srcCur = ch->begin;
+        cc->srcEnd = ch->end;
+        cc->outFd = -1;
+        cc->quiet = 1;
+        if (w->scan) {
+            cc->scanOnly = 1;
+            cc->epilogue = 0;
+            ch->scan = cc;
+        }
+        else {
+            cc->sbcount = ch->sbBase;
+            cc->epilogue = i == w->last;
+            ch->gen = cc;
+        }
+        compile(cc);
+        if (!w->scan)
+            flushCode(cc);
+    }
+    return NULL;
+}
+
+// Run jobWorker() on optJobs threads, this one included
+static void runWave(Wave *w) {
+    pthread_t *threads = (pthread_t*)malloc(optJobs * sizeof(pthread_t));
+    int started = 0;
+
+    w->next = 0;
+    while (started < optJobs - 1 && pthread_create(&threads[started], NULL, jobWorker, w) == 0)
+        started++;
+    jobWorker(w);
+    while (started > 0)
+        pthread_join(threads[--started], NULL);
+    free(threads);
+}
+
+// --emit=binary: the header needs the whole program, so hold on to it
+static void keepOutput(Compiler *master, const Compiler *gen) {
+    while (master->outCap - master->outLen < gen->outLen) {
+        master->outCap *= 2;
+        master->outBuf = (char*)realloc(master->outBuf, master->outCap);
+    }
+    memcpy(master->outBuf + master->outLen, gen->outBuf, gen->outLen);
+    master->outLen += gen->outLen;
+    if (gen->binSlots > master->binSlots)
+        master->binSlots = gen->binSlots;
+}
+
+void compileParallel(Compiler *master) {
+    Chunk *chunks = (Chunk*)calloc(4 * optJobs, sizeof(Chunk));
+    const char *p = master->srcBegin;
+    Wave w = { chunks, 0, 0, 0, -1, master };
+    int done = 0;
+
+    while (!done) {
+        int n = 0, stop;
+
+        // always at least one chunk, so an empty input still gets its epilogue
+        do {
+            const char *e = NULL;
+            if (master->srcEnd - p > CHUNK_SIZE)
+                e = memchr(p + CHUNK_SIZE, '\n', master->srcEnd - p - CHUNK_SIZE);
+            e = e != NULL ? e + 1 : master->srcEnd;
+            chunks[n].begin = p;
+            chunks[n].end = e;
+            p = e;
+            n++;
+        } while (n < 4 * optJobs && p < master->srcEnd);
+        w.last = p == master->srcEnd ? n - 1 : -1;
+
+        w.scan = 1;
+        w.count = n;
+        runWave(&w);
+
+        // a chunk that failed to parse ends the program, later ones do not matter
+        for (stop = 0; stop < n; ) {
+            Compiler *scan = chunks[stop].scan;
+            chunks[stop++].sbBase = master->sbcount;
+            for (int i = 0; i < scan->assignCount; i++) {
+                const Symbol *sym = &scan->table[scan->assigns[i]];
+                int g = intern(master, sym->name, sym->len);
+                if (master->table[g].slot < 0)
+                    master->table[g].slot = master->sbcount++;
+            }
+            if (scan->failed)
+                break;
+        }
+        for (int i = 0; i < n; i++) {
+            // the first pass only adds to the time spent lexing and parsing
+            const Stats *st = &chunks[i].scan->stats;
+            master->stats.ticks[PH_LEX] += st->ticks[PH_LEX];
+            master->stats.ticks[PH_PARSE] += st->ticks[PH_PARSE];
+            master->stats.lexCalls += st->lexCalls;
+            master->stats.lexSamples += st->lexSamples;
+            freeCompiler(chunks[i].scan);
+        }
+
+        w.scan = 0;
+        w.count = stop;
+        runWave(&w);
+
+        for (int i = 0; i < stop; i++) {
+            Compiler *gen = chunks[i].gen;
+            if (!done) {
+                if (gen->failed)
+                    reportError(gen);
+                if (optBinary)
+                    keepOutput(master, gen);
+                else
+                    writeAll(master->outFd, gen->outBuf, gen->outLen);
+                master->cseBase += gen->cseBase;
+                master->cseSaved += gen->cseSaved;
+                mergeStats(&master->stats, &gen->stats);
+                done = master->failed = gen->failed;
+            }
+            freeCompiler(gen);
+        }
+        if (optStats)
+            pollStats(master);
+        if (w.last >= 0)
+            done = 1;
+    }
+    if (optBinary)
+        writeBinary(master);
+    free(chunks);
+}
+
+
+/*============================================================================================
+stats implementation
+============================================================================================*/
+
+/* Statistics (--stats)
+   compile() times every statement and codegen and output time themselves
+   inside it, the rest is lexing and parsing. Lexing happens on demand
+   in the middle of parsing, one token at a time, and a time stamp can
+   cost as much as a token, so lexAhead() only times one call in
+   LEX_SAMPLE; the report scales that up and takes it out of the parse
+   time. Output is flushCode(), with --peephole and --dse in it, and the
+   final write. Time stamps are TSC reads on x86-64 and turn into
+   nanoseconds with the rate measured against CLOCK_MONOTONIC since
+   startStats(). With -j the times of all threads and of both passes add
+   up, the counts are those of the chunks that were written. */
+static struct timespec statStart;
+static unsigned long long statStartTicks;
+unsigned long long statCost;
+static volatile sig_atomic_t statsWanted;
+
+unsigned long long statTicks(void) {
+#if defined(__x86_64__)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#endif
+}
+
+static void onSigusr1(int sig) {
+    (void)sig;
+    statsWanted = 1;
+}
+
+void startStats(void) {
+    struct sigaction sa;
+
+    clock_gettime(CLOCK_MONOTONIC, &statStart);
+    statStartTicks = statTicks();
+    statCost = ~0ull;
+    for (int i = 0; i < 64; i++) {
+        unsigned long long t = statTicks();
+        t = statTicks() - t;
+        if (t < statCost)
+            statCost = t;
+    }
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onSigusr1;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGUSR1, &sa, NULL);
+}
+
+void mergeStats(Stats *to, const Stats *from) {
+    for (int i = 0; i < PH_COUNT; i++)
+        to->ticks[i] += from->ticks[i];
+    to->lexCalls += from->lexCalls;
+    to->lexSamples += from->lexSamples;
+    to->statements += from->statements;
+    to->tokens += from->tokens;
+    to->nodes += from->nodes;
+    if (from->peakNodes > to->peakNodes)
+        to->peakNodes = from->peakNodes;
+    if (from->peakNodeBytes > to->peakNodeBytes)
+        to->peakNodeBytes = from->peakNodeBytes;
+    to->lookups += from->lookups;
+    to->probes += from->probes;
+    for (int i = 0; i <= OP_EXIT; i++)
+        to->ops[i] += from->ops[i];
+    if (from->peakRflag > to->peakRflag)
+        to->peakRflag = from->peakRflag;
+}
+
+void reportStats(const Compiler *cc) {
+    static const char *phaseNames[] = { "lex", "parse", "codegen", "output" };
+    const Stats *st = &cc->stats;
+    struct timespec now;
+    unsigned long long ticks = statTicks() - statStartTicks;
+    double total, nsPerTick, lex, ns[PH_COUNT];
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    total = (now.tv_sec - statStart.tv_sec) * 1e9 + (now.tv_nsec - statStart.tv_nsec);
+    nsPerTick = ticks > 0 ? total / ticks : 1;
+
+    lex = 0;
+    if (st->ticks[PH_LEX] > st->lexSamples * statCost)
+        lex = (double)(st->ticks[PH_LEX] - st->lexSamples * statCost) * st->lexCalls / st->lexSamples;
+    ns[PH_LEX] = lex * nsPerTick;
+    ns[PH_PARSE] = st->ticks[PH_PARSE] > lex ? (st->ticks[PH_PARSE] - lex) * nsPerTick : 0;
+    ns[PH_CODEGEN] = st->ticks[PH_CODEGEN] * nsPerTick;
+    ns[PH_OUTPUT] = st->ticks[PH_OUTPUT] * nsPerTick;
+
+    fprintf(stderr, "{\"ns\": {\"total\": %.0f", total);
+    for (int i = 0; i < PH_COUNT; i++)
+        fprintf(stderr, ", \"%s\": %.0f", phaseNames[i], ns[i]);
+    // the statement being compiled still has its nodes
+    fprintf(stderr, "}, \"statements\": %ld, \"tokens\": %ld, \"nodes\": %ld, \"peak_nodes\": %d,"
+            " \"peak_node_bytes\": %zu, \"symbols\": %ld, \"symbol_lookups\": %ld,"
+            " \"symbol_probes\": %ld, \"peak_rflag\": %d, \"instructions\": {",
+            st->statements, st->tokens, st->nodes + cc->nodecount - 1,
+            st->peakNodes > cc->nodecount - 1 ? st->peakNodes : cc->nodecount - 1,
+            st->peakNodeBytes, st->symbols > 0 ? st->symbols : cc->symcount, st->lookups,
+            st->probes, st->peakRflag);
+    for (int i = 0; i <= OP_EXIT; i++)
+        fprintf(stderr, "%s\"%s\": %ld", i ? ", " : "", opNames[i], st->ops[i]);
+    fprintf(stderr, "}}\n");
+}
+
+void pollStats(const Compiler *cc) {
+    // contexts of -j threads leave the report to the main one
+    if (!statsWanted || cc->quiet)
+        return;
+    statsWanted = 0;
+    reportStats(cc);
+}
+
+
+/*============================================================================================
+batch implementation
+============================================================================================*/
+
+/* Batch compilation (--batch)
+   Files are handed out one at a time to the threads (-j, or one per CPU). Each one gets a
+   fresh context, so symbols, slots and the peephole state never leak
+   from one file into the next, and err() only longjmp()s out of its own
+   compile(). The output of a file is what a run on that file alone would
+   print, written to <file>.s; a file that fails ends in EXIT 1 like
+   always. The error messages come after all files are done, in the
+   order the files were given. */
+typedef struct {
+    const char *path;
+    // 0 compiled, 1 compiled to EXIT 1, -1 not read or not written
+    int status;
+    int errLine;
+} BatchFile;
+
+typedef struct {
+    BatchFile *files;
+    int count;
+    int next;
+    Compiler *total;
+    pthread_mutex_t lock;
+} Batch;
+
+static void compileFile(Batch *b, BatchFile *f) {
+    Compiler *cc = newCompiler(NULL);
+    size_t len = strlen(f->path);
+    char *out = (char*)malloc(len + 3);
+
+    memcpy(out, f->path, len);
+    memcpy(out + len, ".s", 3);
+    f->status = -1;
+    cc->quiet = 1;
+    if (readInput(cc, f->path) == 0) {
+        cc->outFd = open(out, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (cc->outFd < 0) {
+            perror(out);
+        }
+        else {
+            if (optCache)
+                countUses(cc);
+            compile(cc);
+            finish(cc);
+            close(cc->outFd);
+            f->status = cc->failed;
+            f->errLine = cc->errLine;
+        }
+        closeInput(cc);
+    }
+
+    pthread_mutex_lock(&b->lock);
+    b->total->cseBase += cc->cseBase;
+    b->total->cseSaved += cc->cseSaved;
+    mergeStats(&b->total->stats, &cc->stats);
+    b->total->stats.symbols += cc->symcount;
+    pthread_mutex_unlock(&b->lock);
+    free(out);
+    freeCompiler(cc);
+}
+
+static void *batchWorker(void *arg) {
+    Batch *b = (Batch*)arg;
+    int i;
+
+    while ((i = __atomic_fetch_add(&b->next, 1, __ATOMIC_RELAXED)) < b->count)
+        compileFile(b, &b->files[i]);
+    return NULL;
+}
+
+int compileBatch(Compiler *total, char **paths, int count, int threads) {
+    Batch b = { .files = (BatchFile*)calloc(count, sizeof(BatchFile)), .count = count, .total = total };
+    pthread_t *tids;
+    int started = 0, bad = 0;
+
+    if (threads < 1)
+        threads = 1;
+    if (threads > count)
+        threads = count > 0 ? count : 1;
+    tids = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    pthread_mutex_init(&b.lock, NULL);
+    for (int i = 0; i < count; i++)
+        b.files[i].path = paths[i];
+    while (started < threads - 1 && pthread_create(&tids[started], NULL, batchWorker, &b) == 0)
+        started++;
+    batchWorker(&b);
+    while (started > 0)
+        pthread_join(tids[--started], NULL);
+
+    for (int i = 0; i < count; i++) {
+        if (b.files[i].status < 0)
+            bad++;
+        else if (b.files[i].status > 0 && PRINTERR && b.files[i].errLine)
+            fprintf(stderr, "%s: EXIT 1, error() called at %s:%d\n",
+                    b.files[i].path, __FILE__, b.files[i].errLine);
+        else if (b.files[i].status > 0 && PRINTERR)
+            fprintf(stderr, "%s: EXIT 1\n", b.files[i].path);
+        if (b.files[i].status > 0)
+            total->failed = 1;
+    }
+    pthread_mutex_destroy(&b.lock);
+    free(tids);
+    free(b.files);
+    return bad;
+}
+
+
+/*============================================================================================
+server implementation
+============================================================================================*/
+
+/* Compile server (--serve PATH)
+   Every thread of the pool blocks in accept() on the same socket and
+   serves the connection it gets until the client closes it, so up to
+   -j connections are served at once and the rest wait in the backlog.
+   Each request compiles in a fresh context with its text kept in outBuf
+   (outFd < 0), the same way a -j chunk does. With --stats the counts of
+   every request go into one total, printed on SIGUSR1. */
+typedef struct {
+    int fd;
+    Compiler *total;
+    pthread_mutex_t lock;
+} Server;
+
+// Read exactly len bytes, returns 0 at a clean end of the connection
+static int readFull(int fd, char *p, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n = read(fd, p + done, len - done);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return done == 0 && n == 0 ? 0 : -1;
+        done += n;
+    }
+    return 1;
+}
+
+static void reply(int fd, unsigned status, const char *text, size_t len) {
+    char header[8];
+
+    putLE(header, status, 4);
+    putLE(header + 4, (unsigned)len, 4);
+    writeAll(fd, header, sizeof(header));
+    writeAll(fd, text, len);
+}
+
+static void serveConnection(Server *sv, int fd) {
+    char header[4], *text = NULL;
+    size_t cap = 0;
+
+    while (readFull(fd, header, 4) > 0) {
+        unsigned len = getLE((const unsigned char*)header, 4);
+        Compiler *cc;
+
+        if (len > SERVE_MAX_REQUEST) {
+            reply(fd, SERVE_TOO_BIG, NULL, 0);
+            break;
+        }
+        if (len > cap)
+            text = (char*)realloc(text, cap = len);
+        if (readFull(fd, text, len) <= 0)
+            break;
+
+        cc = newCompiler(NULL);
+        cc->srcBegin = cc->srcCur = text;
+        cc->srcEnd = text + len;
+        cc->outFd = -1;
+        cc->quiet = 1;
+        if (optCache)
+            countUses(cc);
+        compile(cc);
+        finish(cc);
+        reply(fd, cc->failed ? SERVE_EXIT1 : SERVE_OK, cc->outBuf, cc->outLen);
+
+        if (optStats || optCse) {
+            pthread_mutex_lock(&sv->lock);
+            sv->total->cseBase += cc->cseBase;
+            sv->total->cseSaved += cc->cseSaved;
+            mergeStats(&sv->total->stats, &cc->stats);
+            sv->total->stats.symbols += cc->symcount;
+            if (optStats)
+                pollStats(sv->total);
+            pthread_mutex_unlock(&sv->lock);
+        }
+        freeCompiler(cc);
+    }
+    free(text);
+    close(fd);
+}
+
+static void *serveWorker(void *arg) {
+    Server *sv = (Server*)arg;
+
+    for (;;) {
+        int fd = accept(sv->fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            perror("accept");
+            return NULL;
+        }
+        serveConnection(sv, fd);
+    }
+}
+
+int serve(Compiler *total, const char *path, int threads) {
+    Server sv = { .fd = -1, .total = total };
+    struct sockaddr_un addr;
+    struct stat st;
+    pthread_t tid;
+
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "%s: socket path too long\n", path);
+        return 1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    // a socket left behind by an earlier server, but never any other file
+    if (stat(path, &st) == 0 && S_ISSOCK(st.st_mode))
+        unlink(path);
+    sv.fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sv.fd < 0 || bind(sv.fd, (struct sockaddr*)&addr, sizeof(addr)) != 0
+        || listen(sv.fd, 128) != 0) {
+        perror(path);
+        return 1;
+    }
+    // a client that goes away in the middle of a reply must not end the server
+    signal(SIGPIPE, SIG_IGN);
+    pthread_mutex_init(&sv.lock, NULL);
+    for (int i = 1; i < threads; i++)
+        if (pthread_create(&tid, NULL, serveWorker, &sv) == 0)
+            pthread_detach(tid);
+    serveWorker(&sv);
+    return 1;
+}
+
+
+/*============================================================================================
+main
+============================================================================================*/
+
+
+
+#ifndef MINIPROJECT_NO_MAIN
+int main(int argc, char *argv[]) {
+    const char *path = NULL;
+    Compiler *cc;
+    char **paths = (char**)malloc(argc * sizeof(char*));
+    int npaths = 0, batchJobs = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--fold") == 0)
+            optFold = 1;
+        else if (strcmp(argv[i], "--fold-program") == 0)
+            optFoldProgram = 1;
+        else if (strcmp(argv[i], "--peephole") == 0)
+            optPeephole = 1;
+        else if (strcmp(argv[i], "--cse") == 0)
+            optCse = 1;
+        else if (strcmp(argv[i], "--superopt") == 0)
+            optSuperopt = 1;
+        else if (strcmp(argv[i], "--flat") == 0)
+            optFlat = 1;
+        else if (strcmp(argv[i], "--dse") == 0)
+            optDse = 1;
+        else if (strcmp(argv[i], "--run") == 0)
+            optRun = 1;
+        else if (strcmp(argv[i], "--stats") == 0)
+            optStats = 1;
+        else if (strcmp(argv[i], "--emit=binary") == 0)
+            optBinary = 1;
+        else if (strcmp(argv[i], "--emit=text") == 0)
+            optBinary = 0;
+        else if (strcmp(argv[i], "--disasm") == 0)
+            optDisasm = 1;
+        else if (strcmp(argv[i], "--batch") == 0)
+            optBatch = 1;
+        else if (strcmp(argv[i], "--serve") == 0 && i + 1 < argc)
+            optServe = argv[++i];
+        else if (strcmp(argv[i], "--jit") == 0)
+            optJit = 1;
+        else if (strcmp(argv[i], "--regs") == 0 && i + 1 < argc) {
+            optRegs = atoi(argv[++i]);
+            if (optRegs < 3) {
+                fprintf(stderr, "--regs needs at least 3 registers\n");
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            optCache = atoi(argv[++i]);
+            if (optCache < 1) {
+                fprintf(stderr, "--cache needs at least 1 register\n");
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            optJobs = atoi(argv[++i]);
+            if (optJobs < 1) {
+                fprintf(stderr, "-j needs at least 1 thread\n");
+                return 1;
+            }
+        }
+        else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 1;
+        }
+        else
+            path = paths[npaths++] = argv[i];
+    }
+    // in a batch -j is the number of files compiled at once, each one
+    // compiles sequentially; the same goes for requests to a server
+    if (optBatch || optServe) {
+        batchJobs = optJobs > 0 ? optJobs : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        optJobs = 0;
+    }
+    // the cache carries registers from one statement to the next
+    if (optCache && (optRegs || optJobs)) {
+        fprintf(stderr, "--cache cannot be combined with --regs or -j\n");
+        return 1;
+    }
+    // --dse looks at the whole program at once
+    if (optDse && optJobs) {
+        fprintf(stderr, "--dse cannot be combined with -j\n");
+        return 1;
+    }
+    // --cse keeps values in as many registers as it needs
+    if (optCse && optRegs) {
+        fprintf(stderr, "--cse cannot be combined with --regs\n");
+        return 1;
+    }
+    // --fold-program prints values only evaluateTree() of a sequential run knows
+    if (optFoldProgram && (optRegs || optCse || optCache || optJobs)) {
+        fprintf(stderr, "--fold-program cannot be combined with --regs, --cse, --cache or -j\n");
+        return 1;
+    }
+    // superEvaluate() is part of evaluateTree(), and the code in the
+    // table does not read every variable the --cache counts expect
+    if (optSuperopt && (optRegs || optCse || optCache)) {
+        fprintf(stderr, "--superopt cannot be combined with --regs, --cse or --cache\n");
+        return 1;
+    }
+#if !defined(__x86_64__)
+    // jitStatement() writes x86-64 machine code and jitRun() calls it
+    if (optJit) {
+        fprintf(stderr, "--jit needs an x86-64 host\n");
+        return 1;
+    }
+#endif
+    // every other pass over a statement reads its BTNodes
+    if (optFlat && (optFold || optRegs || optCse || optCache || optSuperopt || optJit || optJobs)) {
+        fprintf(stderr, "--flat cannot be combined with --fold, --regs, --cse, --cache, --superopt, --jit or -j\n");
+        return 1;
+    }
+    // --run and --jit need the values of a sequential run
+    if (optJobs && (optRun || optJit)) {
+        fprintf(stderr, "-j cannot be combined with --run or --jit\n");
+        return 1;
+    }
+    // --run and --jit print results, not the program
+    if (optBinary && (optRun || optJit)) {
+        fprintf(stderr, "--emit=binary cannot be combined with --run or --jit\n");
+        return 1;
+    }
+    // --run and --jit print to stdout, which the files would share
+    if (optBatch && (optRun || optJit || optDisasm)) {
+        fprintf(stderr, "--batch cannot be combined with --run, --jit or --disasm\n");
+        return 1;
+    }
+    // the server replies with text and nothing else
+    if (optServe && (optBatch || optRun || optJit || optDisasm || optBinary)) {
+        fprintf(stderr, "--serve cannot be combined with --batch, --run, --jit, --disasm or --emit=binary\n");
+        return 1;
+    }
+    if (optServe) {
+        if (optStats)
+            startStats();
+        return serve(newCompiler(NULL), optServe, batchJobs);
+    }
+    if (optBatch) {
+        int bad, cap = argc, fromStdin = npaths == 0;
+        char *line = NULL;
+        size_t lineCap = 0;
+        ssize_t n;
+        // no files named: one path per line on stdin
+        while (fromStdin && (n = getline(&line, &lineCap, stdin)) >= 0) {
+            if (n > 0 && line[n - 1] == '\n')
+                line[--n] = '\0';
+            if (n == 0)
+                continue;
+            if (npaths == cap)
+                paths = (char**)realloc(paths, (cap *= 2) * sizeof(char*));
+            paths[npaths++] = strdup(line);
+        }
+        if (optStats)
+            startStats();
+        cc = newCompiler(NULL);
+        bad = compileBatch(cc, paths, npaths, batchJobs);
+        if (optCse)
+            reportCse(cc);
+        if (optStats)
+            reportStats(cc);
+        freeCompiler(cc);
+        for (int i = 0; fromStdin && i < npaths; i++)
+            free(paths[i]);
+        free(paths);
+        free(line);
+        return bad > 0;
+    }
+    if (optDisasm) {
+        cc = newCompiler(NULL);
+        openInput(cc, path);
+        return disassemble(cc);
+    }
+    if (optStats)
+        startStats();
+    cc = newCompiler(NULL);
+    openInput(cc, path);
+    if (optCache)
+        countUses(cc);
+    if (optJobs) {
+        compileParallel(cc);
+    }
+    else {
+        //printf(">> ");
+        compile(cc);
+        finish(cc);
+    }
+    if (optCse)
+        reportCse(cc);
+    if (optStats) {
+        // the error message does not end its line, unless reportCse() did
+        if (cc->failed && PRINTERR && !optCse)
+            fputc('\n', stderr);
+        reportStats(cc);
     }
     return 0;
 }
+#endif
@@ -0,0 +1,834 @@
+/* Written by bench/superopt.c, do not edit.
+   828 of the 1110 trees of up to 3 leaves have code shorter than what
+   evaluateTree() makes of their subtrees. Sorted by key for
+   superEvaluate(), every entry is followed by its tree and code. */
+static const SuperEntry superTable[] = {
+    { 0x00188, 1, { 0x0a } },  // (0 + 0): MOV r0 0
+    { 0x00189, 1, { 0x09 } },  // (0 + a): MOV r0 a
+    { 0x00198, 1, { 0x09 } },  // (a + 0): MOV r0 a
+    { 0x00199, 2, { 0x09, 0x01 } },  // (a + a): MOV r0 a; ADD r0 r0
+    { 0x00288, 1, { 0x0a } },  // (0 - 0): MOV r0 0
+    { 0x00298, 1, { 0x09 } },  // (a - 0): MOV r0 a
+    { 0x00299, 1, { 0x0a } },  // (a - a): MOV r0 0
+    { 0x00388, 1, { 0x0a } },  // (0 * 0): MOV r0 0
+    { 0x00389, 1, { 0x0a } },  // (0 * a): MOV r0 0
+    { 0x00398, 1, { 0x0a } },  // (a * 0): MOV r0 0
+    { 0x00399, 2, { 0x09, 0x03 } },  // (a * a): MOV r0 a; MUL r0 r0
+    { 0x00588, 1, { 0x0a } },  // (0 & 0): MOV r0 0
+    { 0x00589, 1, { 0x0a } },  // (0 & a): MOV r0 0
+    { 0x00598, 1, { 0x0a } },  // (a & 0): MOV r0 0
+    { 0x00599, 1, { 0x09 } },  // (a & a): MOV r0 a
+    { 0x00688, 1, { 0x0a } },  // (0 | 0): MOV r0 0
+    { 0x00689, 1, { 0x09 } },  // (0 | a): MOV r0 a
+    { 0x00698, 1, { 0x09 } },  // (a | 0): MOV r0 a
+    { 0x00699, 1, { 0x09 } },  // (a | a): MOV r0 a
+    { 0x00788, 1, { 0x0a } },  // (0 ^ 0): MOV r0 0
+    { 0x00789, 1, { 0x09 } },  // (0 ^ a): MOV r0 a
+    { 0x00798, 1, { 0x09 } },  // (a ^ 0): MOV r0 a
+    { 0x00799, 1, { 0x0a } },  // (a ^ a): MOV r0 0
+    { 0x11888, 1, { 0x0a } },  // ((0 + 0) + 0): MOV r0 0
+    { 0x11889, 1, { 0x09 } },  // ((0 + 0) + a): MOV r0 a
+    { 0x11898, 1, { 0x09 } },  // ((0 + a) + 0): MOV r0 a
+    { 0x11899, 2, { 0x09, 0x01 } },  // ((0 + a) + a): MOV r0 a; ADD r0 r0
+    { 0x11988, 1, { 0x09 } },  // ((a + 0) + 0): MOV r0 a
+    { 0x11989, 2, { 0x09, 0x01 } },  // ((a + 0) + a): MOV r0 a; ADD r0 r0
+    { 0x11998, 2, { 0x09, 0x01 } },  // ((a + a) + 0): MOV r0 a; ADD r0 r0
+    { 0x119a8, 3, { 0x09, 0x59, 0x41 } },  // ((a + b) + 0): MOV r0 a; MOV r1 b; ADD r0 r1
+    { 0x119a9, 4, { 0x09, 0x01, 0x59, 0x41 } },  // ((a + b) + a): MOV r0 a; ADD r0 r0; MOV r1 b; ADD r0 r1
+    { 0x119aa, 4, { 0x09, 0x59, 0x41, 0x41 } },  // ((a + b) + b): MOV r0 a; MOV r1 b; ADD r0 r1; ADD r0 r1
+    { 0x12888, 1, { 0x0a } },  // ((0 - 0) + 0): MOV r0 0
+    { 0x12889, 1, { 0x09 } },  // ((0 - 0) + a): MOV r0 a
+    { 0x12898, 3, { 0x09, 0x9a, 0x43 } },  // ((0 - a) + 0): MOV r0 a; MOV r1 -1; MUL r0 r1
+    { 0x12899, 1, { 0x0a } },  // ((0 - a) + a): MOV r0 0
+    { 0x1289a, 3, { 0x49, 0x19, 0x42 } },  // ((0 - a) + b): MOV r0 b; MOV r1 a; SUB r0 r1
+    { 0x12988, 1, { 0x09 } },  // ((a - 0) + 0): MOV r0 a
+    { 0x12989, 2, { 0x09, 0x01 } },  // ((a - 0) + a): MOV r0 a; ADD r0 r0
+    { 0x12998, 1, { 0x0a } },  // ((a - a) + 0): MOV r0 0
+    { 0x12999, 1, { 0x09 } },  // ((a - a) + a): MOV r0 a
+    { 0x1299a, 1, { 0x49 } },  // ((a - a) + b): MOV r0 b
+    { 0x129a8, 3, { 0x09, 0x59, 0x42 } },  // ((a - b) + 0): MOV r0 a; MOV r1 b; SUB r0 r1
+    { 0x129a9, 4, { 0x09, 0x01, 0x59, 0x42 } },  // ((a - b) + a): MOV r0 a; ADD r0 r0; MOV r1 b; SUB r0 r1
+    { 0x129aa, 1, { 0x09 } },  // ((a - b) + b): MOV r0 a
+    { 0x13888, 1, { 0x0a } },  // ((0 * 0) + 0): MOV r0 0
+    { 0x13889, 1, { 0x09 } },  // ((0 * 0) + a): MOV r0 a
+    { 0x13898, 1, { 0x0a } },  // ((0 * a) + 0): MOV r0 0
+    { 0x13899, 1, { 0x09 } },  // ((0 * a) + a): MOV r0 a
+    { 0x1389a, 1, { 0x49 } },  // ((0 * a) + b): MOV r0 b
+    { 0x13988, 1, { 0x0a } },  // ((a * 0) + 0): MOV r0 0
+    { 0x13989, 1, { 0x09 } },  // ((a * 0) + a): MOV r0 a
+    { 0x1398a, 1, { 0x49 } },  // ((a * 0) + b): MOV r0 b
+    { 0x13998, 2, { 0x09, 0x03 } },  // ((a * a) + 0): MOV r0 a; MUL r0 r0
+    { 0x139a8, 3, { 0x09, 0x59, 0x43 } },  // ((a * b) + 0): MOV r0 a; MOV r1 b; MUL r0 r1
+    { 0x139a9, 4, { 0x09, 0x59, 0x13, 0x41 } },  // ((a * b) + a): MOV r0 a; MOV r1 b; MUL r1 r0; ADD r0 r1
+    { 0x139aa, 4, { 0x09, 0x59, 0x43, 0x41 } },  // ((a * b) + b): MOV r0 a; MOV r1 b; MUL r0 r1; ADD r0 r1
+    { 0x15888, 1, { 0x0a } },  // ((0 & 0) + 0): MOV r0 0
+    { 0x15889, 1, { 0x09 } },  // ((0 & 0) + a): MOV r0 a
+    { 0x15898, 1, { 0x0a } },  // ((0 & a) + 0): MOV r0 0
+    { 0x15899, 1, { 0x09 } },  // ((0 & a) + a): MOV r0 a
+    { 0x1589a, 1, { 0x49 } },  // ((0 & a) + b): MOV r0 b
+    { 0x15988, 1, { 0x0a } },  // ((a & 0) + 0): MOV r0 0
+    { 0x15989, 1, { 0x09 } },  // ((a & 0) + a): MOV r0 a
+    { 0x1598a, 1, { 0x49 } },  // ((a & 0) + b): MOV r0 b
+    { 0x15998, 1, { 0x09 } },  // ((a & a) + 0): MOV r0 a
+    { 0x15999, 2, { 0x09, 0x01 } },  // ((a & a) + a): MOV r0 a; ADD r0 r0
+    { 0x159a8, 3, { 0x09, 0x59, 0x45 } },  // ((a & b) + 0): MOV r0 a; MOV r1 b; AND r0 r1
+    { 0x159a9, 4, { 0x09, 0x59, 0x15, 0x41 } },  // ((a & b) + a): MOV r0 a; MOV r1 b; AND r1 r0; ADD r0 r1
+    { 0x159aa, 4, { 0x09, 0x59, 0x45, 0x41 } },  // ((a & b) + b): MOV r0 a; MOV r1 b; AND r0 r1; ADD r0 r1
+    { 0x16888, 1, { 0x0a } },  // ((0 | 0) + 0): MOV r0 0
+    { 0x16889, 1, { 0x09 } },  // ((0 | 0) + a): MOV r0 a
+    { 0x16898, 1, { 0x09 } },  // ((0 | a) + 0): MOV r0 a
+    { 0x16899, 2, { 0x09, 0x01 } },  // ((0 | a) + a): MOV r0 a; ADD r0 r0
+    { 0x16988, 1, { 0x09 } },  // ((a | 0) + 0): MOV r0 a
+    { 0x16989, 2, { 0x09, 0x01 } },  // ((a | 0) + a): MOV r0 a; ADD r0 r0
+    { 0x16998, 1, { 0x09 } },  // ((a | a) + 0): MOV r0 a
+    { 0x16999, 2, { 0x09, 0x01 } },  // ((a | a) + a): MOV r0 a; ADD r0 r0
+    { 0x169a8, 3, { 0x09, 0x59, 0x46 } },  // ((a | b) + 0): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x169a9, 4, { 0x09, 0x59, 0x16, 0x41 } },  // ((a | b) + a): MOV r0 a; MOV r1 b; OR r1 r0; ADD r0 r1
+    { 0x169aa, 4, { 0x09, 0x59, 0x46, 0x41 } },  // ((a | b) + b): MOV r0 a; MOV r1 b; OR r0 r1; ADD r0 r1
+    { 0x17888, 1, { 0x0a } },  // ((0 ^ 0) + 0): MOV r0 0
+    { 0x17889, 1, { 0x09 } },  // ((0 ^ 0) + a): MOV r0 a
+    { 0x17898, 1, { 0x09 } },  // ((0 ^ a) + 0): MOV r0 a
+    { 0x17899, 2, { 0x09, 0x01 } },  // ((0 ^ a) + a): MOV r0 a; ADD r0 r0
+    { 0x17988, 1, { 0x09 } },  // ((a ^ 0) + 0): MOV r0 a
+    { 0x17989, 2, { 0x09, 0x01 } },  // ((a ^ 0) + a): MOV r0 a; ADD r0 r0
+    { 0x17998, 1, { 0x0a } },  // ((a ^ a) + 0): MOV r0 0
+    { 0x17999, 1, { 0x09 } },  // ((a ^ a) + a): MOV r0 a
+    { 0x1799a, 1, { 0x49 } },  // ((a ^ a) + b): MOV r0 b
+    { 0x179a8, 3, { 0x09, 0x59, 0x47 } },  // ((a ^ b) + 0): MOV r0 a; MOV r1 b; XOR r0 r1
+    { 0x179a9, 4, { 0x09, 0x59, 0x17, 0x41 } },  // ((a ^ b) + a): MOV r0 a; MOV r1 b; XOR r1 r0; ADD r0 r1
+    { 0x179aa, 4, { 0x09, 0x59, 0x47, 0x41 } },  // ((a ^ b) + b): MOV r0 a; MOV r1 b; XOR r0 r1; ADD r0 r1
+    { 0x18188, 1, { 0x0a } },  // (0 + (0 + 0)): MOV r0 0
+    { 0x18189, 1, { 0x09 } },  // (0 + (0 + a)): MOV r0 a
+    { 0x18198, 1, { 0x09 } },  // (0 + (a + 0)): MOV r0 a
+    { 0x18199, 2, { 0x09, 0x01 } },  // (0 + (a + a)): MOV r0 a; ADD r0 r0
+    { 0x1819a, 3, { 0x09, 0x59, 0x41 } },  // (0 + (a + b)): MOV r0 a; MOV r1 b; ADD r0 r1
+    { 0x18288, 1, { 0x0a } },  // (0 + (0 - 0)): MOV r0 0
+    { 0x18289, 3, { 0x09, 0x9a, 0x43 } },  // (0 + (0 - a)): MOV r0 a; MOV r1 -1; MUL r0 r1
+    { 0x18298, 1, { 0x09 } },  // (0 + (a - 0)): MOV r0 a
+    { 0x18299, 1, { 0x0a } },  // (0 + (a - a)): MOV r0 0
+    { 0x1829a, 3, { 0x09, 0x59, 0x42 } },  // (0 + (a - b)): MOV r0 a; MOV r1 b; SUB r0 r1
+    { 0x18388, 1, { 0x0a } },  // (0 + (0 * 0)): MOV r0 0
+    { 0x18389, 1, { 0x0a } },  // (0 + (0 * a)): MOV r0 0
+    { 0x18398, 1, { 0x0a } },  // (0 + (a * 0)): MOV r0 0
+    { 0x18399, 2, { 0x09, 0x03 } },  // (0 + (a * a)): MOV r0 a; MUL r0 r0
+    { 0x1839a, 3, { 0x09, 0x59, 0x43 } },  // (0 + (a * b)): MOV r0 a; MOV r1 b; MUL r0 r1
+    { 0x18588, 1, { 0x0a } },  // (0 + (0 & 0)): MOV r0 0
+    { 0x18589, 1, { 0x0a } },  // (0 + (0 & a)): MOV r0 0
+    { 0x18598, 1, { 0x0a } },  // (0 + (a & 0)): MOV r0 0
+    { 0x18599, 1, { 0x09 } },  // (0 + (a & a)): MOV r0 a
+    { 0x1859a, 3, { 0x09, 0x59, 0x45 } },  // (0 + (a & b)): MOV r0 a; MOV r1 b; AND r0 r1
+    { 0x18688, 1, { 0x0a } },  // (0 + (0 | 0)): MOV r0 0
+    { 0x18689, 1, { 0x09 } },  // (0 + (0 | a)): MOV r0 a
+    { 0x18698, 1, { 0x09 } },  // (0 + (a | 0)): MOV r0 a
+    { 0x18699, 1, { 0x09 } },  // (0 + (a | a)): MOV r0 a
+    { 0x1869a, 3, { 0x09, 0x59, 0x46 } },  // (0 + (a | b)): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x18788, 1, { 0x0a } },  // (0 + (0 ^ 0)): MOV r0 0
+    { 0x18789, 1, { 0x09 } },  // (0 + (0 ^ a)): MOV r0 a
+    { 0x18798, 1, { 0x09 } },  // (0 + (a ^ 0)): MOV r0 a
+    { 0x18799, 1, { 0x0a } },  // (0 + (a ^ a)): MOV r0 0
+    { 0x1879a, 3, { 0x09, 0x59, 0x47 } },  // (0 + (a ^ b)): MOV r0 a; MOV r1 b; XOR r0 r1
+    { 0x19188, 1, { 0x09 } },  // (a + (0 + 0)): MOV r0 a
+    { 0x19189, 2, { 0x09, 0x01 } },  // (a + (0 + a)): MOV r0 a; ADD r0 r0
+    { 0x19198, 2, { 0x09, 0x01 } },  // (a + (a + 0)): MOV r0 a; ADD r0 r0
+    { 0x1919a, 4, { 0x09, 0x01, 0x59, 0x41 } },  // (a + (a + b)): MOV r0 a; ADD r0 r0; MOV r1 b; ADD r0 r1
+    { 0x191a9, 4, { 0x09, 0x01, 0x59, 0x41 } },  // (a + (b + a)): MOV r0 a; ADD r0 r0; MOV r1 b; ADD r0 r1
+    { 0x19288, 1, { 0x09 } },  // (a + (0 - 0)): MOV r0 a
+    { 0x19289, 1, { 0x0a } },  // (a + (0 - a)): MOV r0 0
+    { 0x1928a, 3, { 0x09, 0x59, 0x42 } },  // (a + (0 - b)): MOV r0 a; MOV r1 b; SUB r0 r1
+    { 0x19298, 2, { 0x09, 0x01 } },  // (a + (a - 0)): MOV r0 a; ADD r0 r0
+    { 0x19299, 1, { 0x09 } },  // (a + (a - a)): MOV r0 a
+    { 0x1929a, 4, { 0x09, 0x01, 0x59, 0x42 } },  // (a + (a - b)): MOV r0 a; ADD r0 r0; MOV r1 b; SUB r0 r1
+    { 0x192a9, 1, { 0x49 } },  // (a + (b - a)): MOV r0 b
+    { 0x192aa, 1, { 0x09 } },  // (a + (b - b)): MOV r0 a
+    { 0x19388, 1, { 0x09 } },  // (a + (0 * 0)): MOV r0 a
+    { 0x19389, 1, { 0x09 } },  // (a + (0 * a)): MOV r0 a
+    { 0x1938a, 1, { 0x09 } },  // (a + (0 * b)): MOV r0 a
+    { 0x19398, 1, { 0x09 } },  // (a + (a * 0)): MOV r0 a
+    { 0x1939a, 4, { 0x09, 0x59, 0x13, 0x41 } },  // (a + (a * b)): MOV r0 a; MOV r1 b; MUL r1 r0; ADD r0 r1
+    { 0x193a8, 1, { 0x09 } },  // (a + (b * 0)): MOV r0 a
+    { 0x193a9, 4, { 0x09, 0x59, 0x13, 0x41 } },  // (a + (b * a)): MOV r0 a; MOV r1 b; MUL r1 r0; ADD r0 r1
+    { 0x19588, 1, { 0x09 } },  // (a + (0 & 0)): MOV r0 a
+    { 0x19589, 1, { 0x09 } },  // (a + (0 & a)): MOV r0 a
+    { 0x1958a, 1, { 0x09 } },  // (a + (0 & b)): MOV r0 a
+    { 0x19598, 1, { 0x09 } },  // (a + (a & 0)): MOV r0 a
+    { 0x19599, 2, { 0x09, 0x01 } },  // (a + (a & a)): MOV r0 a; ADD r0 r0
+    { 0x1959a, 4, { 0x09, 0x59, 0x15, 0x41 } },  // (a + (a & b)): MOV r0 a; MOV r1 b; AND r1 r0; ADD r0 r1
+    { 0x195a8, 1, { 0x09 } },  // (a + (b & 0)): MOV r0 a
+    { 0x195a9, 4, { 0x09, 0x59, 0x15, 0x41 } },  // (a + (b & a)): MOV r0 a; MOV r1 b; AND r1 r0; ADD r0 r1
+    { 0x19688, 1, { 0x09 } },  // (a + (0 | 0)): MOV r0 a
+    { 0x19689, 2, { 0x09, 0x01 } },  // (a + (0 | a)): MOV r0 a; ADD r0 r0
+    { 0x19698, 2, { 0x09, 0x01 } },  // (a + (a | 0)): MOV r0 a; ADD r0 r0
+    { 0x19699, 2, { 0x09, 0x01 } },  // (a + (a | a)): MOV r0 a; ADD r0 r0
+    { 0x1969a, 4, { 0x09, 0x59, 0x16, 0x41 } },  // (a + (a | b)): MOV r0 a; MOV r1 b; OR r1 r0; ADD r0 r1
+    { 0x196a9, 4, { 0x09, 0x59, 0x16, 0x41 } },  // (a + (b | a)): MOV r0 a; MOV r1 b; OR r1 r0; ADD r0 r1
+    { 0x19788, 1, { 0x09 } },  // (a + (0 ^ 0)): MOV r0 a
+    { 0x19789, 2, { 0x09, 0x01 } },  // (a + (0 ^ a)): MOV r0 a; ADD r0 r0
+    { 0x19798, 2, { 0x09, 0x01 } },  // (a + (a ^ 0)): MOV r0 a; ADD r0 r0
+    { 0x19799, 1, { 0x09 } },  // (a + (a ^ a)): MOV r0 a
+    { 0x1979a, 4, { 0x09, 0x59, 0x17, 0x41 } },  // (a + (a ^ b)): MOV r0 a; MOV r1 b; XOR r1 r0; ADD r0 r1
+    { 0x197a9, 4, { 0x09, 0x59, 0x17, 0x41 } },  // (a + (b ^ a)): MOV r0 a; MOV r1 b; XOR r1 r0; ADD r0 r1
+    { 0x197aa, 1, { 0x09 } },  // (a + (b ^ b)): MOV r0 a
+    { 0x21888, 1, { 0x0a } },  // ((0 + 0) - 0): MOV r0 0
+    { 0x21898, 1, { 0x09 } },  // ((0 + a) - 0): MOV r0 a
+    { 0x21899, 1, { 0x0a } },  // ((0 + a) - a): MOV r0 0
+    { 0x21988, 1, { 0x09 } },  // ((a + 0) - 0): MOV r0 a
+    { 0x21989, 1, { 0x0a } },  // ((a + 0) - a): MOV r0 0
+    { 0x21998, 2, { 0x09, 0x01 } },  // ((a + a) - 0): MOV r0 a; ADD r0 r0
+    { 0x21999, 1, { 0x09 } },  // ((a + a) - a): MOV r0 a
+    { 0x219a8, 3, { 0x09, 0x59, 0x41 } },  // ((a + b) - 0): MOV r0 a; MOV r1 b; ADD r0 r1
+    { 0x219a9, 1, { 0x49 } },  // ((a + b) - a): MOV r0 b
+    { 0x219aa, 1, { 0x09 } },  // ((a + b) - b): MOV r0 a
+    { 0x22888, 1, { 0x0a } },  // ((0 - 0) - 0): MOV r0 0
+    { 0x22898, 3, { 0x09, 0x9a, 0x43 } },  // ((0 - a) - 0): MOV r0 a; MOV r1 -1; MUL r0 r1
+    { 0x22899, 4, { 0x09, 0x01, 0x9a, 0x43 } },  // ((0 - a) - a): MOV r0 a; ADD r0 r0; MOV r1 -1; MUL r0 r1
+    { 0x22988, 1, { 0x09 } },  // ((a - 0) - 0): MOV r0 a
+    { 0x22989, 1, { 0x0a } },  // ((a - 0) - a): MOV r0 0
+    { 0x22998, 1, { 0x0a } },  // ((a - a) - 0): MOV r0 0
+    { 0x229a8, 3, { 0x09, 0x59, 0x42 } },  // ((a - b) - 0): MOV r0 a; MOV r1 b; SUB r0 r1
+    { 0x229a9, 3, { 0x49, 0x9a, 0x43 } },  // ((a - b) - a): MOV r0 b; MOV r1 -1; MUL r0 r1
+    { 0x229aa, 4, { 0x09, 0x59, 0x51, 0x42 } },  // ((a - b) - b): MOV r0 a; MOV r1 b; ADD r1 r1; SUB r0 r1
+    { 0x23888, 1, { 0x0a } },  // ((0 * 0) - 0): MOV r0 0
+    { 0x23898, 1, { 0x0a } },  // ((0 * a) - 0): MOV r0 0
+    { 0x23988, 1, { 0x0a } },  // ((a * 0) - 0): MOV r0 0
+    { 0x23998, 2, { 0x09, 0x03 } },  // ((a * a) - 0): MOV r0 a; MUL r0 r0
+    { 0x239a8, 3, { 0x09, 0x59, 0x43 } },  // ((a * b) - 0): MOV r0 a; MOV r1 b; MUL r0 r1
+    { 0x239a9, 4, { 0x49, 0x19, 0x43, 0x42 } },  // ((a * b) - a): MOV r0 b; MOV r1 a; MUL r0 r1; SUB r0 r1
+    { 0x239aa, 4, { 0x09, 0x59, 0x43, 0x42 } },  // ((a * b) - b): MOV r0 a; MOV r1 b; MUL r0 r1; SUB r0 r1
+    { 0x25888, 1, { 0x0a } },  // ((0 & 0) - 0): MOV r0 0
+    { 0x25898, 1, { 0x0a } },  // ((0 & a) - 0): MOV r0 0
+    { 0x25988, 1, { 0x0a } },  // ((a & 0) - 0): MOV r0 0
+    { 0x25998, 1, { 0x09 } },  // ((a & a) - 0): MOV r0 a
+    { 0x25999, 1, { 0x0a } },  // ((a & a) - a): MOV r0 0
+    { 0x259a8, 3, { 0x09, 0x59, 0x45 } },  // ((a & b) - 0): MOV r0 a; MOV r1 b; AND r0 r1
+    { 0x259a9, 4, { 0x49, 0x19, 0x45, 0x42 } },  // ((a & b) - a): MOV r0 b; MOV r1 a; AND r0 r1; SUB r0 r1
+    { 0x259aa, 4, { 0x09, 0x59, 0x45, 0x42 } },  // ((a & b) - b): MOV r0 a; MOV r1 b; AND r0 r1; SUB r0 r1
+    { 0x26888, 1, { 0x0a } },  // ((0 | 0) - 0): MOV r0 0
+    { 0x26898, 1, { 0x09 } },  // ((0 | a) - 0): MOV r0 a
+    { 0x26899, 1, { 0x0a } },  // ((0 | a) - a): MOV r0 0
+    { 0x26988, 1, { 0x09 } },  // ((a | 0) - 0): MOV r0 a
+    { 0x26989, 1, { 0x0a } },  // ((a | 0) - a): MOV r0 0
+    { 0x26998, 1, { 0x09 } },  // ((a | a) - 0): MOV r0 a
+    { 0x26999, 1, { 0x0a } },  // ((a | a) - a): MOV r0 0
+    { 0x269a8, 3, { 0x09, 0x59, 0x46 } },  // ((a | b) - 0): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x269a9, 4, { 0x09, 0x59, 0x45, 0x47 } },  // ((a | b) - a): MOV r0 a; MOV r1 b; AND r0 r1; XOR r0 r1
+    { 0x269aa, 4, { 0x09, 0x59, 0x15, 0x42 } },  // ((a | b) - b): MOV r0 a; MOV r1 b; AND r1 r0; SUB r0 r1
+    { 0x27888, 1, { 0x0a } },  // ((0 ^ 0) - 0): MOV r0 0
+    { 0x27898, 1, { 0x09 } },  // ((0 ^ a) - 0): MOV r0 a
+    { 0x27899, 1, { 0x0a } },  // ((0 ^ a) - a): MOV r0 0
+    { 0x27988, 1, { 0x09 } },  // ((a ^ 0) - 0): MOV r0 a
+    { 0x27989, 1, { 0x0a } },  // ((a ^ 0) - a): MOV r0 0
+    { 0x27998, 1, { 0x0a } },  // ((a ^ a) - 0): MOV r0 0
+    { 0x279a8, 3, { 0x09, 0x59, 0x47 } },  // ((a ^ b) - 0): MOV r0 a; MOV r1 b; XOR r0 r1
+    { 0x279a9, 4, { 0x49, 0x19, 0x47, 0x42 } },  // ((a ^ b) - a): MOV r0 b; MOV r1 a; XOR r0 r1; SUB r0 r1
+    { 0x279aa, 4, { 0x09, 0x59, 0x47, 0x42 } },  // ((a ^ b) - b): MOV r0 a; MOV r1 b; XOR r0 r1; SUB r0 r1
+    { 0x28188, 1, { 0x0a } },  // (0 - (0 + 0)): MOV r0 0
+    { 0x28288, 1, { 0x0a } },  // (0 - (0 - 0)): MOV r0 0
+    { 0x28289, 1, { 0x09 } },  // (0 - (0 - a)): MOV r0 a
+    { 0x28299, 1, { 0x0a } },  // (0 - (a - a)): MOV r0 0
+    { 0x2829a, 3, { 0x49, 0x19, 0x42 } },  // (0 - (a - b)): MOV r0 b; MOV r1 a; SUB r0 r1
+    { 0x28388, 1, { 0x0a } },  // (0 - (0 * 0)): MOV r0 0
+    { 0x28389, 1, { 0x0a } },  // (0 - (0 * a)): MOV r0 0
+    { 0x28398, 1, { 0x0a } },  // (0 - (a * 0)): MOV r0 0
+    { 0x28588, 1, { 0x0a } },  // (0 - (0 & 0)): MOV r0 0
+    { 0x28589, 1, { 0x0a } },  // (0 - (0 & a)): MOV r0 0
+    { 0x28598, 1, { 0x0a } },  // (0 - (a & 0)): MOV r0 0
+    { 0x28688, 1, { 0x0a } },  // (0 - (0 | 0)): MOV r0 0
+    { 0x28788, 1, { 0x0a } },  // (0 - (0 ^ 0)): MOV r0 0
+    { 0x28799, 1, { 0x0a } },  // (0 - (a ^ a)): MOV r0 0
+    { 0x29188, 1, { 0x09 } },  // (a - (0 + 0)): MOV r0 a
+    { 0x29189, 1, { 0x0a } },  // (a - (0 + a)): MOV r0 0
+    { 0x29198, 1, { 0x0a } },  // (a - (a + 0)): MOV r0 0
+    { 0x29199, 3, { 0x09, 0x9a, 0x43 } },  // (a - (a + a)): MOV r0 a; MOV r1 -1; MUL r0 r1
+    { 0x2919a, 3, { 0x49, 0x9a, 0x43 } },  // (a - (a + b)): MOV r0 b; MOV r1 -1; MUL r0 r1
+    { 0x291a9, 3, { 0x49, 0x9a, 0x43 } },  // (a - (b + a)): MOV r0 b; MOV r1 -1; MUL r0 r1
+    { 0x29288, 1, { 0x09 } },  // (a - (0 - 0)): MOV r0 a
+    { 0x29289, 2, { 0x09, 0x01 } },  // (a - (0 - a)): MOV r0 a; ADD r0 r0
+    { 0x2928a, 3, { 0x09, 0x59, 0x41 } },  // (a - (0 - b)): MOV r0 a; MOV r1 b; ADD r0 r1
+    { 0x29298, 1, { 0x0a } },  // (a - (a - 0)): MOV r0 0
+    { 0x29299, 1, { 0x09 } },  // (a - (a - a)): MOV r0 a
+    { 0x2929a, 1, { 0x49 } },  // (a - (a - b)): MOV r0 b
+    { 0x292a9, 4, { 0x09, 0x01, 0x59, 0x42 } },  // (a - (b - a)): MOV r0 a; ADD r0 r0; MOV r1 b; SUB r0 r1
+    { 0x292aa, 1, { 0x09 } },  // (a - (b - b)): MOV r0 a
+    { 0x29388, 1, { 0x09 } },  // (a - (0 * 0)): MOV r0 a
+    { 0x29389, 1, { 0x09 } },  // (a - (0 * a)): MOV r0 a
+    { 0x2938a, 1, { 0x09 } },  // (a - (0 * b)): MOV r0 a
+    { 0x29398, 1, { 0x09 } },  // (a - (a * 0)): MOV r0 a
+    { 0x2939a, 4, { 0x09, 0x59, 0x13, 0x42 } },  // (a - (a * b)): MOV r0 a; MOV r1 b; MUL r1 r0; SUB r0 r1
+    { 0x293a8, 1, { 0x09 } },  // (a - (b * 0)): MOV r0 a
+    { 0x293a9, 4, { 0x09, 0x59, 0x13, 0x42 } },  // (a - (b * a)): MOV r0 a; MOV r1 b; MUL r1 r0; SUB r0 r1
+    { 0x29588, 1, { 0x09 } },  // (a - (0 & 0)): MOV r0 a
+    { 0x29589, 1, { 0x09 } },  // (a - (0 & a)): MOV r0 a
+    { 0x2958a, 1, { 0x09 } },  // (a - (0 & b)): MOV r0 a
+    { 0x29598, 1, { 0x09 } },  // (a - (a & 0)): MOV r0 a
+    { 0x29599, 1, { 0x0a } },  // (a - (a & a)): MOV r0 0
+    { 0x2959a, 4, { 0x09, 0x59, 0x15, 0x42 } },  // (a - (a & b)): MOV r0 a; MOV r1 b; AND r1 r0; SUB r0 r1
+    { 0x295a8, 1, { 0x09 } },  // (a - (b & 0)): MOV r0 a
+    { 0x295a9, 4, { 0x09, 0x59, 0x15, 0x42 } },  // (a - (b & a)): MOV r0 a; MOV r1 b; AND r1 r0; SUB r0 r1
+    { 0x29688, 1, { 0x09 } },  // (a - (0 | 0)): MOV r0 a
+    { 0x29689, 1, { 0x0a } },  // (a - (0 | a)): MOV r0 0
+    { 0x29698, 1, { 0x0a } },  // (a - (a | 0)): MOV r0 0
+    { 0x29699, 1, { 0x0a } },  // (a - (a | a)): MOV r0 0
+    { 0x2969a, 4, { 0x09, 0x59, 0x45, 0x42 } },  // (a - (a | b)): MOV r0 a; MOV r1 b; AND r0 r1; SUB r0 r1
+    { 0x296a9, 4, { 0x09, 0x59, 0x45, 0x42 } },  // (a - (b | a)): MOV r0 a; MOV r1 b; AND r0 r1; SUB r0 r1
+    { 0x29788, 1, { 0x09 } },  // (a - (0 ^ 0)): MOV r0 a
+    { 0x29789, 1, { 0x0a } },  // (a - (0 ^ a)): MOV r0 0
+    { 0x29798, 1, { 0x0a } },  // (a - (a ^ 0)): MOV r0 0
+    { 0x29799, 1, { 0x09 } },  // (a - (a ^ a)): MOV r0 a
+    { 0x2979a, 4, { 0x09, 0x59, 0x17, 0x42 } },  // (a - (a ^ b)): MOV r0 a; MOV r1 b; XOR r1 r0; SUB r0 r1
+    { 0x297a9, 4, { 0x09, 0x59, 0x17, 0x42 } },  // (a - (b ^ a)): MOV r0 a; MOV r1 b; XOR r1 r0; SUB r0 r1
+    { 0x297aa, 1, { 0x09 } },  // (a - (b ^ b)): MOV r0 a
+    { 0x31888, 1, { 0x0a } },  // ((0 + 0) * 0): MOV r0 0
+    { 0x31889, 1, { 0x0a } },  // ((0 + 0) * a): MOV r0 0
+    { 0x31898, 1, { 0x0a } },  // ((0 + a) * 0): MOV r0 0
+    { 0x31899, 2, { 0x09, 0x03 } },  // ((0 + a) * a): MOV r0 a; MUL r0 r0
+    { 0x31988, 1, { 0x0a } },  // ((a + 0) * 0): MOV r0 0
+    { 0x31989, 2, { 0x09, 0x03 } },  // ((a + 0) * a): MOV r0 a; MUL r0 r0
+    { 0x31998, 1, { 0x0a } },  // ((a + a) * 0): MOV r0 0
+    { 0x31999, 3, { 0x09, 0x03, 0x01 } },  // ((a + a) * a): MOV r0 a; MUL r0 r0; ADD r0 r0
+    { 0x319a8, 1, { 0x0a } },  // ((a + b) * 0): MOV r0 0
+    { 0x319a9, 4, { 0x09, 0x59, 0x11, 0x43 } },  // ((a + b) * a): MOV r0 a; MOV r1 b; ADD r1 r0; MUL r0 r1
+    { 0x319aa, 4, { 0x09, 0x59, 0x41, 0x43 } },  // ((a + b) * b): MOV r0 a; MOV r1 b; ADD r0 r1; MUL r0 r1
+    { 0x32888, 1, { 0x0a } },  // ((0 - 0) * 0): MOV r0 0
+    { 0x32889, 1, { 0x0a } },  // ((0 - 0) * a): MOV r0 0
+    { 0x32898, 1, { 0x0a } },  // ((0 - a) * 0): MOV r0 0
+    { 0x32899, 4, { 0x09, 0x03, 0x9a, 0x43 } },  // ((0 - a) * a): MOV r0 a; MUL r0 r0; MOV r1 -1; MUL r0 r1
+    { 0x32988, 1, { 0x0a } },  // ((a - 0) * 0): MOV r0 0
+    { 0x32989, 2, { 0x09, 0x03 } },  // ((a - 0) * a): MOV r0 a; MUL r0 r0
+    { 0x32998, 1, { 0x0a } },  // ((a - a) * 0): MOV r0 0
+    { 0x32999, 1, { 0x0a } },  // ((a - a) * a): MOV r0 0
+    { 0x3299a, 1, { 0x0a } },  // ((a - a) * b): MOV r0 0
+    { 0x329a8, 1, { 0x0a } },  // ((a - b) * 0): MOV r0 0
+    { 0x329aa, 4, { 0x09, 0x59, 0x42, 0x43 } },  // ((a - b) * b): MOV r0 a; MOV r1 b; SUB r0 r1; MUL r0 r1
+    { 0x33888, 1, { 0x0a } },  // ((0 * 0) * 0): MOV r0 0
+    { 0x33889, 1, { 0x0a } },  // ((0 * 0) * a): MOV r0 0
+    { 0x33898, 1, { 0x0a } },  // ((0 * a) * 0): MOV r0 0
+    { 0x33899, 1, { 0x0a } },  // ((0 * a) * a): MOV r0 0
+    { 0x3389a, 1, { 0x0a } },  // ((0 * a) * b): MOV r0 0
+    { 0x33988, 1, { 0x0a } },  // ((a * 0) * 0): MOV r0 0
+    { 0x33989, 1, { 0x0a } },  // ((a * 0) * a): MOV r0 0
+    { 0x3398a, 1, { 0x0a } },  // ((a * 0) * b): MOV r0 0
+    { 0x33998, 1, { 0x0a } },  // ((a * a) * 0): MOV r0 0
+    { 0x339a8, 1, { 0x0a } },  // ((a * b) * 0): MOV r0 0
+    { 0x339a9, 4, { 0x09, 0x03, 0x59, 0x43 } },  // ((a * b) * a): MOV r0 a; MUL r0 r0; MOV r1 b; MUL r0 r1
+    { 0x339aa, 4, { 0x09, 0x59, 0x43, 0x43 } },  // ((a * b) * b): MOV r0 a; MOV r1 b; MUL r0 r1; MUL r0 r1
+    { 0x35888, 1, { 0x0a } },  // ((0 & 0) * 0): MOV r0 0
+    { 0x35889, 1, { 0x0a } },  // ((0 & 0) * a): MOV r0 0
+    { 0x35898, 1, { 0x0a } },  // ((0 & a) * 0): MOV r0 0
+    { 0x35899, 1, { 0x0a } },  // ((0 & a) * a): MOV r0 0
+    { 0x3589a, 1, { 0x0a } },  // ((0 & a) * b): MOV r0 0
+    { 0x35988, 1, { 0x0a } },  // ((a & 0) * 0): MOV r0 0
+    { 0x35989, 1, { 0x0a } },  // ((a & 0) * a): MOV r0 0
+    { 0x3598a, 1, { 0x0a } },  // ((a & 0) * b): MOV r0 0
+    { 0x35998, 1, { 0x0a } },  // ((a & a) * 0): MOV r0 0
+    { 0x35999, 2, { 0x09, 0x03 } },  // ((a & a) * a): MOV r0 a; MUL r0 r0
+    { 0x359a8, 1, { 0x0a } },  // ((a & b) * 0): MOV r0 0
+    { 0x359a9, 4, { 0x09, 0x59, 0x15, 0x43 } },  // ((a & b) * a): MOV r0 a; MOV r1 b; AND r1 r0; MUL r0 r1
+    { 0x359aa, 4, { 0x09, 0x59, 0x45, 0x43 } },  // ((a & b) * b): MOV r0 a; MOV r1 b; AND r0 r1; MUL r0 r1
+    { 0x36888, 1, { 0x0a } },  // ((0 | 0) * 0): MOV r0 0
+    { 0x36889, 1, { 0x0a } },  // ((0 | 0) * a): MOV r0 0
+    { 0x36898, 1, { 0x0a } },  // ((0 | a) * 0): MOV r0 0
+    { 0x36899, 2, { 0x09, 0x03 } },  // ((0 | a) * a): MOV r0 a; MUL r0 r0
+    { 0x36988, 1, { 0x0a } },  // ((a | 0) * 0): MOV r0 0
+    { 0x36989, 2, { 0x09, 0x03 } },  // ((a | 0) * a): MOV r0 a; MUL r0 r0
+    { 0x36998, 1, { 0x0a } },  // ((a | a) * 0): MOV r0 0
+    { 0x36999, 2, { 0x09, 0x03 } },  // ((a | a) * a): MOV r0 a; MUL r0 r0
+    { 0x369a8, 1, { 0x0a } },  // ((a | b) * 0): MOV r0 0
+    { 0x369a9, 4, { 0x09, 0x59, 0x16, 0x43 } },  // ((a | b) * a): MOV r0 a; MOV r1 b; OR r1 r0; MUL r0 r1
+    { 0x369aa, 4, { 0x09, 0x59, 0x46, 0x43 } },  // ((a | b) * b): MOV r0 a; MOV r1 b; OR r0 r1; MUL r0 r1
+    { 0x37888, 1, { 0x0a } },  // ((0 ^ 0) * 0): MOV r0 0
+    { 0x37889, 1, { 0x0a } },  // ((0 ^ 0) * a): MOV r0 0
+    { 0x37898, 1, { 0x0a } },  // ((0 ^ a) * 0): MOV r0 0
+    { 0x37899, 2, { 0x09, 0x03 } },  // ((0 ^ a) * a): MOV r0 a; MUL r0 r0
+    { 0x37988, 1, { 0x0a } },  // ((a ^ 0) * 0): MOV r0 0
+    { 0x37989, 2, { 0x09, 0x03 } },  // ((a ^ 0) * a): MOV r0 a; MUL r0 r0
+    { 0x37998, 1, { 0x0a } },  // ((a ^ a) * 0): MOV r0 0
+    { 0x37999, 1, { 0x0a } },  // ((a ^ a) * a): MOV r0 0
+    { 0x3799a, 1, { 0x0a } },  // ((a ^ a) * b): MOV r0 0
+    { 0x379a8, 1, { 0x0a } },  // ((a ^ b) * 0): MOV r0 0
+    { 0x379a9, 4, { 0x09, 0x59, 0x17, 0x43 } },  // ((a ^ b) * a): MOV r0 a; MOV r1 b; XOR r1 r0; MUL r0 r1
+    { 0x379aa, 4, { 0x09, 0x59, 0x47, 0x43 } },  // ((a ^ b) * b): MOV r0 a; MOV r1 b; XOR r0 r1; MUL r0 r1
+    { 0x38188, 1, { 0x0a } },  // (0 * (0 + 0)): MOV r0 0
+    { 0x38189, 1, { 0x0a } },  // (0 * (0 + a)): MOV r0 0
+    { 0x38198, 1, { 0x0a } },  // (0 * (a + 0)): MOV r0 0
+    { 0x38199, 1, { 0x0a } },  // (0 * (a + a)): MOV r0 0
+    { 0x3819a, 1, { 0x0a } },  // (0 * (a + b)): MOV r0 0
+    { 0x38288, 1, { 0x0a } },  // (0 * (0 - 0)): MOV r0 0
+    { 0x38289, 1, { 0x0a } },  // (0 * (0 - a)): MOV r0 0
+    { 0x38298, 1, { 0x0a } },  // (0 * (a - 0)): MOV r0 0
+    { 0x38299, 1, { 0x0a } },  // (0 * (a - a)): MOV r0 0
+    { 0x3829a, 1, { 0x0a } },  // (0 * (a - b)): MOV r0 0
+    { 0x38388, 1, { 0x0a } },  // (0 * (0 * 0)): MOV r0 0
+    { 0x38389, 1, { 0x0a } },  // (0 * (0 * a)): MOV r0 0
+    { 0x38398, 1, { 0x0a } },  // (0 * (a * 0)): MOV r0 0
+    { 0x38399, 1, { 0x0a } },  // (0 * (a * a)): MOV r0 0
+    { 0x3839a, 1, { 0x0a } },  // (0 * (a * b)): MOV r0 0
+    { 0x38588, 1, { 0x0a } },  // (0 * (0 & 0)): MOV r0 0
+    { 0x38589, 1, { 0x0a } },  // (0 * (0 & a)): MOV r0 0
+    { 0x38598, 1, { 0x0a } },  // (0 * (a & 0)): MOV r0 0
+    { 0x38599, 1, { 0x0a } },  // (0 * (a & a)): MOV r0 0
+    { 0x3859a, 1, { 0x0a } },  // (0 * (a & b)): MOV r0 0
+    { 0x38688, 1, { 0x0a } },  // (0 * (0 | 0)): MOV r0 0
+    { 0x38689, 1, { 0x0a } },  // (0 * (0 | a)): MOV r0 0
+    { 0x38698, 1, { 0x0a } },  // (0 * (a | 0)): MOV r0 0
+    { 0x38699, 1, { 0x0a } },  // (0 * (a | a)): MOV r0 0
+    { 0x3869a, 1, { 0x0a } },  // (0 * (a | b)): MOV r0 0
+    { 0x38788, 1, { 0x0a } },  // (0 * (0 ^ 0)): MOV r0 0
+    { 0x38789, 1, { 0x0a } },  // (0 * (0 ^ a)): MOV r0 0
+    { 0x38798, 1, { 0x0a } },  // (0 * (a ^ 0)): MOV r0 0
+    { 0x38799, 1, { 0x0a } },  // (0 * (a ^ a)): MOV r0 0
+    { 0x3879a, 1, { 0x0a } },  // (0 * (a ^ b)): MOV r0 0
+    { 0x39188, 1, { 0x0a } },  // (a * (0 + 0)): MOV r0 0
+    { 0x39189, 2, { 0x09, 0x03 } },  // (a * (0 + a)): MOV r0 a; MUL r0 r0
+    { 0x39198, 2, { 0x09, 0x03 } },  // (a * (a + 0)): MOV r0 a; MUL r0 r0
+    { 0x39199, 3, { 0x09, 0x03, 0x01 } },  // (a * (a + a)): MOV r0 a; MUL r0 r0; ADD r0 r0
+    { 0x3919a, 4, { 0x09, 0x59, 0x11, 0x43 } },  // (a * (a + b)): MOV r0 a; MOV r1 b; ADD r1 r0; MUL r0 r1
+    { 0x391a9, 4, { 0x09, 0x59, 0x11, 0x43 } },  // (a * (b + a)): MOV r0 a; MOV r1 b; ADD r1 r0; MUL r0 r1
+    { 0x39288, 1, { 0x0a } },  // (a * (0 - 0)): MOV r0 0
+    { 0x39289, 4, { 0x09, 0x03, 0x9a, 0x43 } },  // (a * (0 - a)): MOV r0 a; MUL r0 r0; MOV r1 -1; MUL r0 r1
+    { 0x39298, 2, { 0x09, 0x03 } },  // (a * (a - 0)): MOV r0 a; MUL r0 r0
+    { 0x39299, 1, { 0x0a } },  // (a * (a - a)): MOV r0 0
+    { 0x392a9, 4, { 0x09, 0x59, 0x12, 0x43 } },  // (a * (b - a)): MOV r0 a; MOV r1 b; SUB r1 r0; MUL r0 r1
+    { 0x392aa, 1, { 0x0a } },  // (a * (b - b)): MOV r0 0
+    { 0x39388, 1, { 0x0a } },  // (a * (0 * 0)): MOV r0 0
+    { 0x39389, 1, { 0x0a } },  // (a * (0 * a)): MOV r0 0
+    { 0x3938a, 1, { 0x0a } },  // (a * (0 * b)): MOV r0 0
+    { 0x39398, 1, { 0x0a } },  // (a * (a * 0)): MOV r0 0
+    { 0x3939a, 4, { 0x09, 0x03, 0x59, 0x43 } },  // (a * (a * b)): MOV r0 a; MUL r0 r0; MOV r1 b; MUL r0 r1
+    { 0x393a8, 1, { 0x0a } },  // (a * (b * 0)): MOV r0 0
+    { 0x393a9, 4, { 0x09, 0x03, 0x59, 0x43 } },  // (a * (b * a)): MOV r0 a; MUL r0 r0; MOV r1 b; MUL r0 r1
+    { 0x39588, 1, { 0x0a } },  // (a * (0 & 0)): MOV r0 0
+    { 0x39589, 1, { 0x0a } },  // (a * (0 & a)): MOV r0 0
+    { 0x3958a, 1, { 0x0a } },  // (a * (0 & b)): MOV r0 0
+    { 0x39598, 1, { 0x0a } },  // (a * (a & 0)): MOV r0 0
+    { 0x39599, 2, { 0x09, 0x03 } },  // (a * (a & a)): MOV r0 a; MUL r0 r0
+    { 0x3959a, 4, { 0x09, 0x59, 0x15, 0x43 } },  // (a * (a & b)): MOV r0 a; MOV r1 b; AND r1 r0; MUL r0 r1
+    { 0x395a8, 1, { 0x0a } },  // (a * (b & 0)): MOV r0 0
+    { 0x395a9, 4, { 0x09, 0x59, 0x15, 0x43 } },  // (a * (b & a)): MOV r0 a; MOV r1 b; AND r1 r0; MUL r0 r1
+    { 0x39688, 1, { 0x0a } },  // (a * (0 | 0)): MOV r0 0
+    { 0x39689, 2, { 0x09, 0x03 } },  // (a * (0 | a)): MOV r0 a; MUL r0 r0
+    { 0x39698, 2, { 0x09, 0x03 } },  // (a * (a | 0)): MOV r0 a; MUL r0 r0
+    { 0x39699, 2, { 0x09, 0x03 } },  // (a * (a | a)): MOV r0 a; MUL r0 r0
+    { 0x3969a, 4, { 0x09, 0x59, 0x16, 0x43 } },  // (a * (a | b)): MOV r0 a; MOV r1 b; OR r1 r0; MUL r0 r1
+    { 0x396a9, 4, { 0x09, 0x59, 0x16, 0x43 } },  // (a * (b | a)): MOV r0 a; MOV r1 b; OR r1 r0; MUL r0 r1
+    { 0x39788, 1, { 0x0a } },  // (a * (0 ^ 0)): MOV r0 0
+    { 0x39789, 2, { 0x09, 0x03 } },  // (a * (0 ^ a)): MOV r0 a; MUL r0 r0
+    { 0x39798, 2, { 0x09, 0x03 } },  // (a * (a ^ 0)): MOV r0 a; MUL r0 r0
+    { 0x39799, 1, { 0x0a } },  // (a * (a ^ a)): MOV r0 0
+    { 0x3979a, 4, { 0x09, 0x59, 0x17, 0x43 } },  // (a * (a ^ b)): MOV r0 a; MOV r1 b; XOR r1 r0; MUL r0 r1
+    { 0x397a9, 4, { 0x09, 0x59, 0x17, 0x43 } },  // (a * (b ^ a)): MOV r0 a; MOV r1 b; XOR r1 r0; MUL r0 r1
+    { 0x397aa, 1, { 0x0a } },  // (a * (b ^ b)): MOV r0 0
+    { 0x51888, 1, { 0x0a } },  // ((0 + 0) & 0): MOV r0 0
+    { 0x51889, 1, { 0x0a } },  // ((0 + 0) & a): MOV r0 0
+    { 0x51898, 1, { 0x0a } },  // ((0 + a) & 0): MOV r0 0
+    { 0x51899, 1, { 0x09 } },  // ((0 + a) & a): MOV r0 a
+    { 0x51988, 1, { 0x0a } },  // ((a + 0) & 0): MOV r0 0
+    { 0x51989, 1, { 0x09 } },  // ((a + 0) & a): MOV r0 a
+    { 0x51998, 1, { 0x0a } },  // ((a + a) & 0): MOV r0 0
+    { 0x519a8, 1, { 0x0a } },  // ((a + b) & 0): MOV r0 0
+    { 0x519a9, 4, { 0x09, 0x59, 0x11, 0x45 } },  // ((a + b) & a): MOV r0 a; MOV r1 b; ADD r1 r0; AND r0 r1
+    { 0x519aa, 4, { 0x09, 0x59, 0x41, 0x45 } },  // ((a + b) & b): MOV r0 a; MOV r1 b; ADD r0 r1; AND r0 r1
+    { 0x52888, 1, { 0x0a } },  // ((0 - 0) & 0): MOV r0 0
+    { 0x52889, 1, { 0x0a } },  // ((0 - 0) & a): MOV r0 0
+    { 0x52898, 1, { 0x0a } },  // ((0 - a) & 0): MOV r0 0
+    { 0x52899, 4, { 0x09, 0x1a, 0x12, 0x45 } },  // ((0 - a) & a): MOV r0 a; MOV r1 0; SUB r1 r0; AND r0 r1
+    { 0x52988, 1, { 0x0a } },  // ((a - 0) & 0): MOV r0 0
+    { 0x52989, 1, { 0x09 } },  // ((a - 0) & a): MOV r0 a
+    { 0x52998, 1, { 0x0a } },  // ((a - a) & 0): MOV r0 0
+    { 0x52999, 1, { 0x0a } },  // ((a - a) & a): MOV r0 0
+    { 0x5299a, 1, { 0x0a } },  // ((a - a) & b): MOV r0 0
+    { 0x529a8, 1, { 0x0a } },  // ((a - b) & 0): MOV r0 0
+    { 0x529aa, 4, { 0x09, 0x59, 0x42, 0x45 } },  // ((a - b) & b): MOV r0 a; MOV r1 b; SUB r0 r1; AND r0 r1
+    { 0x53888, 1, { 0x0a } },  // ((0 * 0) & 0): MOV r0 0
+    { 0x53889, 1, { 0x0a } },  // ((0 * 0) & a): MOV r0 0
+    { 0x53898, 1, { 0x0a } },  // ((0 * a) & 0): MOV r0 0
+    { 0x53899, 1, { 0x0a } },  // ((0 * a) & a): MOV r0 0
+    { 0x5389a, 1, { 0x0a } },  // ((0 * a) & b): MOV r0 0
+    { 0x53988, 1, { 0x0a } },  // ((a * 0) & 0): MOV r0 0
+    { 0x53989, 1, { 0x0a } },  // ((a * 0) & a): MOV r0 0
+    { 0x5398a, 1, { 0x0a } },  // ((a * 0) & b): MOV r0 0
+    { 0x53998, 1, { 0x0a } },  // ((a * a) & 0): MOV r0 0
+    { 0x539a8, 1, { 0x0a } },  // ((a * b) & 0): MOV r0 0
+    { 0x539a9, 4, { 0x09, 0x59, 0x13, 0x45 } },  // ((a * b) & a): MOV r0 a; MOV r1 b; MUL r1 r0; AND r0 r1
+    { 0x539aa, 4, { 0x09, 0x59, 0x43, 0x45 } },  // ((a * b) & b): MOV r0 a; MOV r1 b; MUL r0 r1; AND r0 r1
+    { 0x55888, 1, { 0x0a } },  // ((0 & 0) & 0): MOV r0 0
+    { 0x55889, 1, { 0x0a } },  // ((0 & 0) & a): MOV r0 0
+    { 0x55898, 1, { 0x0a } },  // ((0 & a) & 0): MOV r0 0
+    { 0x55899, 1, { 0x0a } },  // ((0 & a) & a): MOV r0 0
+    { 0x5589a, 1, { 0x0a } },  // ((0 & a) & b): MOV r0 0
+    { 0x55988, 1, { 0x0a } },  // ((a & 0) & 0): MOV r0 0
+    { 0x55989, 1, { 0x0a } },  // ((a & 0) & a): MOV r0 0
+    { 0x5598a, 1, { 0x0a } },  // ((a & 0) & b): MOV r0 0
+    { 0x55998, 1, { 0x0a } },  // ((a & a) & 0): MOV r0 0
+    { 0x55999, 1, { 0x09 } },  // ((a & a) & a): MOV r0 a
+    { 0x559a8, 1, { 0x0a } },  // ((a & b) & 0): MOV r0 0
+    { 0x559a9, 3, { 0x09, 0x59, 0x45 } },  // ((a & b) & a): MOV r0 a; MOV r1 b; AND r0 r1
+    { 0x559aa, 3, { 0x09, 0x59, 0x45 } },  // ((a & b) & b): MOV r0 a; MOV r1 b; AND r0 r1
+    { 0x56888, 1, { 0x0a } },  // ((0 | 0) & 0): MOV r0 0
+    { 0x56889, 1, { 0x0a } },  // ((0 | 0) & a): MOV r0 0
+    { 0x56898, 1, { 0x0a } },  // ((0 | a) & 0): MOV r0 0
+    { 0x56899, 1, { 0x09 } },  // ((0 | a) & a): MOV r0 a
+    { 0x56988, 1, { 0x0a } },  // ((a | 0) & 0): MOV r0 0
+    { 0x56989, 1, { 0x09 } },  // ((a | 0) & a): MOV r0 a
+    { 0x56998, 1, { 0x0a } },  // ((a | a) & 0): MOV r0 0
+    { 0x56999, 1, { 0x09 } },  // ((a | a) & a): MOV r0 a
+    { 0x569a8, 1, { 0x0a } },  // ((a | b) & 0): MOV r0 0
+    { 0x569a9, 1, { 0x09 } },  // ((a | b) & a): MOV r0 a
+    { 0x569aa, 1, { 0x49 } },  // ((a | b) & b): MOV r0 b
+    { 0x57888, 1, { 0x0a } },  // ((0 ^ 0) & 0): MOV r0 0
+    { 0x57889, 1, { 0x0a } },  // ((0 ^ 0) & a): MOV r0 0
+    { 0x57898, 1, { 0x0a } },  // ((0 ^ a) & 0): MOV r0 0
+    { 0x57899, 1, { 0x09 } },  // ((0 ^ a) & a): MOV r0 a
+    { 0x57988, 1, { 0x0a } },  // ((a ^ 0) & 0): MOV r0 0
+    { 0x57989, 1, { 0x09 } },  // ((a ^ 0) & a): MOV r0 a
+    { 0x57998, 1, { 0x0a } },  // ((a ^ a) & 0): MOV r0 0
+    { 0x57999, 1, { 0x0a } },  // ((a ^ a) & a): MOV r0 0
+    { 0x5799a, 1, { 0x0a } },  // ((a ^ a) & b): MOV r0 0
+    { 0x579a8, 1, { 0x0a } },  // ((a ^ b) & 0): MOV r0 0
+    { 0x579a9, 4, { 0x09, 0x59, 0x15, 0x42 } },  // ((a ^ b) & a): MOV r0 a; MOV r1 b; AND r1 r0; SUB r0 r1
+    { 0x579aa, 4, { 0x09, 0x59, 0x45, 0x47 } },  // ((a ^ b) & b): MOV r0 a; MOV r1 b; AND r0 r1; XOR r0 r1
+    { 0x58188, 1, { 0x0a } },  // (0 & (0 + 0)): MOV r0 0
+    { 0x58189, 1, { 0x0a } },  // (0 & (0 + a)): MOV r0 0
+    { 0x58198, 1, { 0x0a } },  // (0 & (a + 0)): MOV r0 0
+    { 0x58199, 1, { 0x0a } },  // (0 & (a + a)): MOV r0 0
+    { 0x5819a, 1, { 0x0a } },  // (0 & (a + b)): MOV r0 0
+    { 0x58288, 1, { 0x0a } },  // (0 & (0 - 0)): MOV r0 0
+    { 0x58289, 1, { 0x0a } },  // (0 & (0 - a)): MOV r0 0
+    { 0x58298, 1, { 0x0a } },  // (0 & (a - 0)): MOV r0 0
+    { 0x58299, 1, { 0x0a } },  // (0 & (a - a)): MOV r0 0
+    { 0x5829a, 1, { 0x0a } },  // (0 & (a - b)): MOV r0 0
+    { 0x58388, 1, { 0x0a } },  // (0 & (0 * 0)): MOV r0 0
+    { 0x58389, 1, { 0x0a } },  // (0 & (0 * a)): MOV r0 0
+    { 0x58398, 1, { 0x0a } },  // (0 & (a * 0)): MOV r0 0
+    { 0x58399, 1, { 0x0a } },  // (0 & (a * a)): MOV r0 0
+    { 0x5839a, 1, { 0x0a } },  // (0 & (a * b)): MOV r0 0
+    { 0x58588, 1, { 0x0a } },  // (0 & (0 & 0)): MOV r0 0
+    { 0x58589, 1, { 0x0a } },  // (0 & (0 & a)): MOV r0 0
+    { 0x58598, 1, { 0x0a } },  // (0 & (a & 0)): MOV r0 0
+    { 0x58599, 1, { 0x0a } },  // (0 & (a & a)): MOV r0 0
+    { 0x5859a, 1, { 0x0a } },  // (0 & (a & b)): MOV r0 0
+    { 0x58688, 1, { 0x0a } },  // (0 & (0 | 0)): MOV r0 0
+    { 0x58689, 1, { 0x0a } },  // (0 & (0 | a)): MOV r0 0
+    { 0x58698, 1, { 0x0a } },  // (0 & (a | 0)): MOV r0 0
+    { 0x58699, 1, { 0x0a } },  // (0 & (a | a)): MOV r0 0
+    { 0x5869a, 1, { 0x0a } },  // (0 & (a | b)): MOV r0 0
+    { 0x58788, 1, { 0x0a } },  // (0 & (0 ^ 0)): MOV r0 0
+    { 0x58789, 1, { 0x0a } },  // (0 & (0 ^ a)): MOV r0 0
+    { 0x58798, 1, { 0x0a } },  // (0 & (a ^ 0)): MOV r0 0
+    { 0x58799, 1, { 0x0a } },  // (0 & (a ^ a)): MOV r0 0
+    { 0x5879a, 1, { 0x0a } },  // (0 & (a ^ b)): MOV r0 0
+    { 0x59188, 1, { 0x0a } },  // (a & (0 + 0)): MOV r0 0
+    { 0x59189, 1, { 0x09 } },  // (a & (0 + a)): MOV r0 a
+    { 0x59198, 1, { 0x09 } },  // (a & (a + 0)): MOV r0 a
+    { 0x5919a, 4, { 0x09, 0x59, 0x11, 0x45 } },  // (a & (a + b)): MOV r0 a; MOV r1 b; ADD r1 r0; AND r0 r1
+    { 0x591a9, 4, { 0x09, 0x59, 0x11, 0x45 } },  // (a & (b + a)): MOV r0 a; MOV r1 b; ADD r1 r0; AND r0 r1
+    { 0x59288, 1, { 0x0a } },  // (a & (0 - 0)): MOV r0 0
+    { 0x59289, 4, { 0x09, 0x1a, 0x12, 0x45 } },  // (a & (0 - a)): MOV r0 a; MOV r1 0; SUB r1 r0; AND r0 r1
+    { 0x59298, 1, { 0x09 } },  // (a & (a - 0)): MOV r0 a
+    { 0x59299, 1, { 0x0a } },  // (a & (a - a)): MOV r0 0
+    { 0x592a9, 4, { 0x09, 0x59, 0x12, 0x45 } },  // (a & (b - a)): MOV r0 a; MOV r1 b; SUB r1 r0; AND r0 r1
+    { 0x592aa, 1, { 0x0a } },  // (a & (b - b)): MOV r0 0
+    { 0x59388, 1, { 0x0a } },  // (a & (0 * 0)): MOV r0 0
+    { 0x59389, 1, { 0x0a } },  // (a & (0 * a)): MOV r0 0
+    { 0x5938a, 1, { 0x0a } },  // (a & (0 * b)): MOV r0 0
+    { 0x59398, 1, { 0x0a } },  // (a & (a * 0)): MOV r0 0
+    { 0x5939a, 4, { 0x09, 0x59, 0x13, 0x45 } },  // (a & (a * b)): MOV r0 a; MOV r1 b; MUL r1 r0; AND r0 r1
+    { 0x593a8, 1, { 0x0a } },  // (a & (b * 0)): MOV r0 0
+    { 0x593a9, 4, { 0x09, 0x59, 0x13, 0x45 } },  // (a & (b * a)): MOV r0 a; MOV r1 b; MUL r1 r0; AND r0 r1
+    { 0x59588, 1, { 0x0a } },  // (a & (0 & 0)): MOV r0 0
+    { 0x59589, 1, { 0x0a } },  // (a & (0 & a)): MOV r0 0
+    { 0x5958a, 1, { 0x0a } },  // (a & (0 & b)): MOV r0 0
+    { 0x59598, 1, { 0x0a } },  // (a & (a & 0)): MOV r0 0
+    { 0x59599, 1, { 0x09 } },  // (a & (a & a)): MOV r0 a
+    { 0x5959a, 3, { 0x09, 0x59, 0x45 } },  // (a & (a & b)): MOV r0 a; MOV r1 b; AND r0 r1
+    { 0x595a8, 1, { 0x0a } },  // (a & (b & 0)): MOV r0 0
+    { 0x595a9, 3, { 0x09, 0x59, 0x45 } },  // (a & (b & a)): MOV r0 a; MOV r1 b; AND r0 r1
+    { 0x59688, 1, { 0x0a } },  // (a & (0 | 0)): MOV r0 0
+    { 0x59689, 1, { 0x09 } },  // (a & (0 | a)): MOV r0 a
+    { 0x59698, 1, { 0x09 } },  // (a & (a | 0)): MOV r0 a
+    { 0x59699, 1, { 0x09 } },  // (a & (a | a)): MOV r0 a
+    { 0x5969a, 1, { 0x09 } },  // (a & (a | b)): MOV r0 a
+    { 0x596a9, 1, { 0x09 } },  // (a & (b | a)): MOV r0 a
+    { 0x59788, 1, { 0x0a } },  // (a & (0 ^ 0)): MOV r0 0
+    { 0x59789, 1, { 0x09 } },  // (a & (0 ^ a)): MOV r0 a
+    { 0x59798, 1, { 0x09 } },  // (a & (a ^ 0)): MOV r0 a
+    { 0x59799, 1, { 0x0a } },  // (a & (a ^ a)): MOV r0 0
+    { 0x5979a, 4, { 0x09, 0x59, 0x15, 0x42 } },  // (a & (a ^ b)): MOV r0 a; MOV r1 b; AND r1 r0; SUB r0 r1
+    { 0x597a9, 4, { 0x09, 0x59, 0x15, 0x42 } },  // (a & (b ^ a)): MOV r0 a; MOV r1 b; AND r1 r0; SUB r0 r1
+    { 0x597aa, 1, { 0x0a } },  // (a & (b ^ b)): MOV r0 0
+    { 0x61888, 1, { 0x0a } },  // ((0 + 0) | 0): MOV r0 0
+    { 0x61889, 1, { 0x09 } },  // ((0 + 0) | a): MOV r0 a
+    { 0x61898, 1, { 0x09 } },  // ((0 + a) | 0): MOV r0 a
+    { 0x61899, 1, { 0x09 } },  // ((0 + a) | a): MOV r0 a
+    { 0x61988, 1, { 0x09 } },  // ((a + 0) | 0): MOV r0 a
+    { 0x61989, 1, { 0x09 } },  // ((a + 0) | a): MOV r0 a
+    { 0x61998, 2, { 0x09, 0x01 } },  // ((a + a) | 0): MOV r0 a; ADD r0 r0
+    { 0x619a8, 3, { 0x09, 0x59, 0x41 } },  // ((a + b) | 0): MOV r0 a; MOV r1 b; ADD r0 r1
+    { 0x619a9, 4, { 0x09, 0x59, 0x11, 0x46 } },  // ((a + b) | a): MOV r0 a; MOV r1 b; ADD r1 r0; OR r0 r1
+    { 0x619aa, 4, { 0x09, 0x59, 0x41, 0x46 } },  // ((a + b) | b): MOV r0 a; MOV r1 b; ADD r0 r1; OR r0 r1
+    { 0x62888, 1, { 0x0a } },  // ((0 - 0) | 0): MOV r0 0
+    { 0x62889, 1, { 0x09 } },  // ((0 - 0) | a): MOV r0 a
+    { 0x62898, 3, { 0x09, 0x9a, 0x43 } },  // ((0 - a) | 0): MOV r0 a; MOV r1 -1; MUL r0 r1
+    { 0x62899, 4, { 0x09, 0x1a, 0x12, 0x46 } },  // ((0 - a) | a): MOV r0 a; MOV r1 0; SUB r1 r0; OR r0 r1
+    { 0x62988, 1, { 0x09 } },  // ((a - 0) | 0): MOV r0 a
+    { 0x62989, 1, { 0x09 } },  // ((a - 0) | a): MOV r0 a
+    { 0x62998, 1, { 0x0a } },  // ((a - a) | 0): MOV r0 0
+    { 0x62999, 1, { 0x09 } },  // ((a - a) | a): MOV r0 a
+    { 0x6299a, 1, { 0x49 } },  // ((a - a) | b): MOV r0 b
+    { 0x629a8, 3, { 0x09, 0x59, 0x42 } },  // ((a - b) | 0): MOV r0 a; MOV r1 b; SUB r0 r1
+    { 0x629aa, 4, { 0x09, 0x59, 0x42, 0x46 } },  // ((a - b) | b): MOV r0 a; MOV r1 b; SUB r0 r1; OR r0 r1
+    { 0x63888, 1, { 0x0a } },  // ((0 * 0) | 0): MOV r0 0
+    { 0x63889, 1, { 0x09 } },  // ((0 * 0) | a): MOV r0 a
+    { 0x63898, 1, { 0x0a } },  // ((0 * a) | 0): MOV r0 0
+    { 0x63899, 1, { 0x09 } },  // ((0 * a) | a): MOV r0 a
+    { 0x6389a, 1, { 0x49 } },  // ((0 * a) | b): MOV r0 b
+    { 0x63988, 1, { 0x0a } },  // ((a * 0) | 0): MOV r0 0
+    { 0x63989, 1, { 0x09 } },  // ((a * 0) | a): MOV r0 a
+    { 0x6398a, 1, { 0x49 } },  // ((a * 0) | b): MOV r0 b
+    { 0x63998, 2, { 0x09, 0x03 } },  // ((a * a) | 0): MOV r0 a; MUL r0 r0
+    { 0x639a8, 3, { 0x09, 0x59, 0x43 } },  // ((a * b) | 0): MOV r0 a; MOV r1 b; MUL r0 r1
+    { 0x639a9, 4, { 0x09, 0x59, 0x13, 0x46 } },  // ((a * b) | a): MOV r0 a; MOV r1 b; MUL r1 r0; OR r0 r1
+    { 0x639aa, 4, { 0x09, 0x59, 0x43, 0x46 } },  // ((a * b) | b): MOV r0 a; MOV r1 b; MUL r0 r1; OR r0 r1
+    { 0x65888, 1, { 0x0a } },  // ((0 & 0) | 0): MOV r0 0
+    { 0x65889, 1, { 0x09 } },  // ((0 & 0) | a): MOV r0 a
+    { 0x65898, 1, { 0x0a } },  // ((0 & a) | 0): MOV r0 0
+    { 0x65899, 1, { 0x09 } },  // ((0 & a) | a): MOV r0 a
+    { 0x6589a, 1, { 0x49 } },  // ((0 & a) | b): MOV r0 b
+    { 0x65988, 1, { 0x0a } },  // ((a & 0) | 0): MOV r0 0
+    { 0x65989, 1, { 0x09 } },  // ((a & 0) | a): MOV r0 a
+    { 0x6598a, 1, { 0x49 } },  // ((a & 0) | b): MOV r0 b
+    { 0x65998, 1, { 0x09 } },  // ((a & a) | 0): MOV r0 a
+    { 0x65999, 1, { 0x09 } },  // ((a & a) | a): MOV r0 a
+    { 0x659a8, 3, { 0x09, 0x59, 0x45 } },  // ((a & b) | 0): MOV r0 a; MOV r1 b; AND r0 r1
+    { 0x659a9, 1, { 0x09 } },  // ((a & b) | a): MOV r0 a
+    { 0x659aa, 1, { 0x49 } },  // ((a & b) | b): MOV r0 b
+    { 0x66888, 1, { 0x0a } },  // ((0 | 0) | 0): MOV r0 0
+    { 0x66889, 1, { 0x09 } },  // ((0 | 0) | a): MOV r0 a
+    { 0x66898, 1, { 0x09 } },  // ((0 | a) | 0): MOV r0 a
+    { 0x66899, 1, { 0x09 } },  // ((0 | a) | a): MOV r0 a
+    { 0x66988, 1, { 0x09 } },  // ((a | 0) | 0): MOV r0 a
+    { 0x66989, 1, { 0x09 } },  // ((a | 0) | a): MOV r0 a
+    { 0x66998, 1, { 0x09 } },  // ((a | a) | 0): MOV r0 a
+    { 0x66999, 1, { 0x09 } },  // ((a | a) | a): MOV r0 a
+    { 0x669a8, 3, { 0x09, 0x59, 0x46 } },  // ((a | b) | 0): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x669a9, 3, { 0x09, 0x59, 0x46 } },  // ((a | b) | a): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x669aa, 3, { 0x09, 0x59, 0x46 } },  // ((a | b) | b): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x67888, 1, { 0x0a } },  // ((0 ^ 0) | 0): MOV r0 0
+    { 0x67889, 1, { 0x09 } },  // ((0 ^ 0) | a): MOV r0 a
+    { 0x67898, 1, { 0x09 } },  // ((0 ^ a) | 0): MOV r0 a
+    { 0x67899, 1, { 0x09 } },  // ((0 ^ a) | a): MOV r0 a
+    { 0x67988, 1, { 0x09 } },  // ((a ^ 0) | 0): MOV r0 a
+    { 0x67989, 1, { 0x09 } },  // ((a ^ 0) | a): MOV r0 a
+    { 0x67998, 1, { 0x0a } },  // ((a ^ a) | 0): MOV r0 0
+    { 0x67999, 1, { 0x09 } },  // ((a ^ a) | a): MOV r0 a
+    { 0x6799a, 1, { 0x49 } },  // ((a ^ a) | b): MOV r0 b
+    { 0x679a8, 3, { 0x09, 0x59, 0x47 } },  // ((a ^ b) | 0): MOV r0 a; MOV r1 b; XOR r0 r1
+    { 0x679a9, 3, { 0x09, 0x59, 0x46 } },  // ((a ^ b) | a): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x679aa, 3, { 0x09, 0x59, 0x46 } },  // ((a ^ b) | b): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x68188, 1, { 0x0a } },  // (0 | (0 + 0)): MOV r0 0
+    { 0x68189, 1, { 0x09 } },  // (0 | (0 + a)): MOV r0 a
+    { 0x68198, 1, { 0x09 } },  // (0 | (a + 0)): MOV r0 a
+    { 0x68199, 2, { 0x09, 0x01 } },  // (0 | (a + a)): MOV r0 a; ADD r0 r0
+    { 0x6819a, 3, { 0x09, 0x59, 0x41 } },  // (0 | (a + b)): MOV r0 a; MOV r1 b; ADD r0 r1
+    { 0x68288, 1, { 0x0a } },  // (0 | (0 - 0)): MOV r0 0
+    { 0x68289, 3, { 0x09, 0x9a, 0x43 } },  // (0 | (0 - a)): MOV r0 a; MOV r1 -1; MUL r0 r1
+    { 0x68298, 1, { 0x09 } },  // (0 | (a - 0)): MOV r0 a
+    { 0x68299, 1, { 0x0a } },  // (0 | (a - a)): MOV r0 0
+    { 0x6829a, 3, { 0x09, 0x59, 0x42 } },  // (0 | (a - b)): MOV r0 a; MOV r1 b; SUB r0 r1
+    { 0x68388, 1, { 0x0a } },  // (0 | (0 * 0)): MOV r0 0
+    { 0x68389, 1, { 0x0a } },  // (0 | (0 * a)): MOV r0 0
+    { 0x68398, 1, { 0x0a } },  // (0 | (a * 0)): MOV r0 0
+    { 0x68399, 2, { 0x09, 0x03 } },  // (0 | (a * a)): MOV r0 a; MUL r0 r0
+    { 0x6839a, 3, { 0x09, 0x59, 0x43 } },  // (0 | (a * b)): MOV r0 a; MOV r1 b; MUL r0 r1
+    { 0x68588, 1, { 0x0a } },  // (0 | (0 & 0)): MOV r0 0
+    { 0x68589, 1, { 0x0a } },  // (0 | (0 & a)): MOV r0 0
+    { 0x68598, 1, { 0x0a } },  // (0 | (a & 0)): MOV r0 0
+    { 0x68599, 1, { 0x09 } },  // (0 | (a & a)): MOV r0 a
+    { 0x6859a, 3, { 0x09, 0x59, 0x45 } },  // (0 | (a & b)): MOV r0 a; MOV r1 b; AND r0 r1
+    { 0x68688, 1, { 0x0a } },  // (0 | (0 | 0)): MOV r0 0
+    { 0x68689, 1, { 0x09 } },  // (0 | (0 | a)): MOV r0 a
+    { 0x68698, 1, { 0x09 } },  // (0 | (a | 0)): MOV r0 a
+    { 0x68699, 1, { 0x09 } },  // (0 | (a | a)): MOV r0 a
+    { 0x6869a, 3, { 0x09, 0x59, 0x46 } },  // (0 | (a | b)): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x68788, 1, { 0x0a } },  // (0 | (0 ^ 0)): MOV r0 0
+    { 0x68789, 1, { 0x09 } },  // (0 | (0 ^ a)): MOV r0 a
+    { 0x68798, 1, { 0x09 } },  // (0 | (a ^ 0)): MOV r0 a
+    { 0x68799, 1, { 0x0a } },  // (0 | (a ^ a)): MOV r0 0
+    { 0x6879a, 3, { 0x09, 0x59, 0x47 } },  // (0 | (a ^ b)): MOV r0 a; MOV r1 b; XOR r0 r1
+    { 0x69188, 1, { 0x09 } },  // (a | (0 + 0)): MOV r0 a
+    { 0x69189, 1, { 0x09 } },  // (a | (0 + a)): MOV r0 a
+    { 0x69198, 1, { 0x09 } },  // (a | (a + 0)): MOV r0 a
+    { 0x6919a, 4, { 0x09, 0x59, 0x11, 0x46 } },  // (a | (a + b)): MOV r0 a; MOV r1 b; ADD r1 r0; OR r0 r1
+    { 0x691a9, 4, { 0x09, 0x59, 0x11, 0x46 } },  // (a | (b + a)): MOV r0 a; MOV r1 b; ADD r1 r0; OR r0 r1
+    { 0x69288, 1, { 0x09 } },  // (a | (0 - 0)): MOV r0 a
+    { 0x69289, 4, { 0x09, 0x1a, 0x12, 0x46 } },  // (a | (0 - a)): MOV r0 a; MOV r1 0; SUB r1 r0; OR r0 r1
+    { 0x69298, 1, { 0x09 } },  // (a | (a - 0)): MOV r0 a
+    { 0x69299, 1, { 0x09 } },  // (a | (a - a)): MOV r0 a
+    { 0x692a9, 4, { 0x09, 0x59, 0x12, 0x46 } },  // (a | (b - a)): MOV r0 a; MOV r1 b; SUB r1 r0; OR r0 r1
+    { 0x692aa, 1, { 0x09 } },  // (a | (b - b)): MOV r0 a
+    { 0x69388, 1, { 0x09 } },  // (a | (0 * 0)): MOV r0 a
+    { 0x69389, 1, { 0x09 } },  // (a | (0 * a)): MOV r0 a
+    { 0x6938a, 1, { 0x09 } },  // (a | (0 * b)): MOV r0 a
+    { 0x69398, 1, { 0x09 } },  // (a | (a * 0)): MOV r0 a
+    { 0x6939a, 4, { 0x09, 0x59, 0x13, 0x46 } },  // (a | (a * b)): MOV r0 a; MOV r1 b; MUL r1 r0; OR r0 r1
+    { 0x693a8, 1, { 0x09 } },  // (a | (b * 0)): MOV r0 a
+    { 0x693a9, 4, { 0x09, 0x59, 0x13, 0x46 } },  // (a | (b * a)): MOV r0 a; MOV r1 b; MUL r1 r0; OR r0 r1
+    { 0x69588, 1, { 0x09 } },  // (a | (0 & 0)): MOV r0 a
+    { 0x69589, 1, { 0x09 } },  // (a | (0 & a)): MOV r0 a
+    { 0x6958a, 1, { 0x09 } },  // (a | (0 & b)): MOV r0 a
+    { 0x69598, 1, { 0x09 } },  // (a | (a & 0)): MOV r0 a
+    { 0x69599, 1, { 0x09 } },  // (a | (a & a)): MOV r0 a
+    { 0x6959a, 1, { 0x09 } },  // (a | (a & b)): MOV r0 a
+    { 0x695a8, 1, { 0x09 } },  // (a | (b & 0)): MOV r0 a
+    { 0x695a9, 1, { 0x09 } },  // (a | (b & a)): MOV r0 a
+    { 0x69688, 1, { 0x09 } },  // (a | (0 | 0)): MOV r0 a
+    { 0x69689, 1, { 0x09 } },  // (a | (0 | a)): MOV r0 a
+    { 0x69698, 1, { 0x09 } },  // (a | (a | 0)): MOV r0 a
+    { 0x69699, 1, { 0x09 } },  // (a | (a | a)): MOV r0 a
+    { 0x6969a, 3, { 0x09, 0x59, 0x46 } },  // (a | (a | b)): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x696a9, 3, { 0x09, 0x59, 0x46 } },  // (a | (b | a)): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x69788, 1, { 0x09 } },  // (a | (0 ^ 0)): MOV r0 a
+    { 0x69789, 1, { 0x09 } },  // (a | (0 ^ a)): MOV r0 a
+    { 0x69798, 1, { 0x09 } },  // (a | (a ^ 0)): MOV r0 a
+    { 0x69799, 1, { 0x09 } },  // (a | (a ^ a)): MOV r0 a
+    { 0x6979a, 3, { 0x09, 0x59, 0x46 } },  // (a | (a ^ b)): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x697a9, 3, { 0x09, 0x59, 0x46 } },  // (a | (b ^ a)): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x697aa, 1, { 0x09 } },  // (a | (b ^ b)): MOV r0 a
+    { 0x71888, 1, { 0x0a } },  // ((0 + 0) ^ 0): MOV r0 0
+    { 0x71889, 1, { 0x09 } },  // ((0 + 0) ^ a): MOV r0 a
+    { 0x71898, 1, { 0x09 } },  // ((0 + a) ^ 0): MOV r0 a
+    { 0x71899, 1, { 0x0a } },  // ((0 + a) ^ a): MOV r0 0
+    { 0x71988, 1, { 0x09 } },  // ((a + 0) ^ 0): MOV r0 a
+    { 0x71989, 1, { 0x0a } },  // ((a + 0) ^ a): MOV r0 0
+    { 0x71998, 2, { 0x09, 0x01 } },  // ((a + a) ^ 0): MOV r0 a; ADD r0 r0
+    { 0x719a8, 3, { 0x09, 0x59, 0x41 } },  // ((a + b) ^ 0): MOV r0 a; MOV r1 b; ADD r0 r1
+    { 0x719a9, 4, { 0x09, 0x59, 0x11, 0x47 } },  // ((a + b) ^ a): MOV r0 a; MOV r1 b; ADD r1 r0; XOR r0 r1
+    { 0x719aa, 4, { 0x09, 0x59, 0x41, 0x47 } },  // ((a + b) ^ b): MOV r0 a; MOV r1 b; ADD r0 r1; XOR r0 r1
+    { 0x72888, 1, { 0x0a } },  // ((0 - 0) ^ 0): MOV r0 0
+    { 0x72889, 1, { 0x09 } },  // ((0 - 0) ^ a): MOV r0 a
+    { 0x72898, 3, { 0x09, 0x9a, 0x43 } },  // ((0 - a) ^ 0): MOV r0 a; MOV r1 -1; MUL r0 r1
+    { 0x72899, 4, { 0x09, 0x1a, 0x12, 0x47 } },  // ((0 - a) ^ a): MOV r0 a; MOV r1 0; SUB r1 r0; XOR r0 r1
+    { 0x72988, 1, { 0x09 } },  // ((a - 0) ^ 0): MOV r0 a
+    { 0x72989, 1, { 0x0a } },  // ((a - 0) ^ a): MOV r0 0
+    { 0x72998, 1, { 0x0a } },  // ((a - a) ^ 0): MOV r0 0
+    { 0x72999, 1, { 0x09 } },  // ((a - a) ^ a): MOV r0 a
+    { 0x7299a, 1, { 0x49 } },  // ((a - a) ^ b): MOV r0 b
+    { 0x729a8, 3, { 0x09, 0x59, 0x42 } },  // ((a - b) ^ 0): MOV r0 a; MOV r1 b; SUB r0 r1
+    { 0x729aa, 4, { 0x09, 0x59, 0x42, 0x47 } },  // ((a - b) ^ b): MOV r0 a; MOV r1 b; SUB r0 r1; XOR r0 r1
+    { 0x73888, 1, { 0x0a } },  // ((0 * 0) ^ 0): MOV r0 0
+    { 0x73889, 1, { 0x09 } },  // ((0 * 0) ^ a): MOV r0 a
+    { 0x73898, 1, { 0x0a } },  // ((0 * a) ^ 0): MOV r0 0
+    { 0x73899, 1, { 0x09 } },  // ((0 * a) ^ a): MOV r0 a
+    { 0x7389a, 1, { 0x49 } },  // ((0 * a) ^ b): MOV r0 b
+    { 0x73988, 1, { 0x0a } },  // ((a * 0) ^ 0): MOV r0 0
+    { 0x73989, 1, { 0x09 } },  // ((a * 0) ^ a): MOV r0 a
+    { 0x7398a, 1, { 0x49 } },  // ((a * 0) ^ b): MOV r0 b
+    { 0x73998, 2, { 0x09, 0x03 } },  // ((a * a) ^ 0): MOV r0 a; MUL r0 r0
+    { 0x739a8, 3, { 0x09, 0x59, 0x43 } },  // ((a * b) ^ 0): MOV r0 a; MOV r1 b; MUL r0 r1
+    { 0x739a9, 4, { 0x09, 0x59, 0x13, 0x47 } },  // ((a * b) ^ a): MOV r0 a; MOV r1 b; MUL r1 r0; XOR r0 r1
+    { 0x739aa, 4, { 0x09, 0x59, 0x43, 0x47 } },  // ((a * b) ^ b): MOV r0 a; MOV r1 b; MUL r0 r1; XOR r0 r1
+    { 0x75888, 1, { 0x0a } },  // ((0 & 0) ^ 0): MOV r0 0
+    { 0x75889, 1, { 0x09 } },  // ((0 & 0) ^ a): MOV r0 a
+    { 0x75898, 1, { 0x0a } },  // ((0 & a) ^ 0): MOV r0 0
+    { 0x75899, 1, { 0x09 } },  // ((0 & a) ^ a): MOV r0 a
+    { 0x7589a, 1, { 0x49 } },  // ((0 & a) ^ b): MOV r0 b
+    { 0x75988, 1, { 0x0a } },  // ((a & 0) ^ 0): MOV r0 0
+    { 0x75989, 1, { 0x09 } },  // ((a & 0) ^ a): MOV r0 a
+    { 0x7598a, 1, { 0x49 } },  // ((a & 0) ^ b): MOV r0 b
+    { 0x75998, 1, { 0x09 } },  // ((a & a) ^ 0): MOV r0 a
+    { 0x75999, 1, { 0x0a } },  // ((a & a) ^ a): MOV r0 0
+    { 0x759a8, 3, { 0x09, 0x59, 0x45 } },  // ((a & b) ^ 0): MOV r0 a; MOV r1 b; AND r0 r1
+    { 0x759a9, 4, { 0x09, 0x59, 0x15, 0x42 } },  // ((a & b) ^ a): MOV r0 a; MOV r1 b; AND r1 r0; SUB r0 r1
+    { 0x759aa, 4, { 0x09, 0x59, 0x45, 0x47 } },  // ((a & b) ^ b): MOV r0 a; MOV r1 b; AND r0 r1; XOR r0 r1
+    { 0x76888, 1, { 0x0a } },  // ((0 | 0) ^ 0): MOV r0 0
+    { 0x76889, 1, { 0x09 } },  // ((0 | 0) ^ a): MOV r0 a
+    { 0x76898, 1, { 0x09 } },  // ((0 | a) ^ 0): MOV r0 a
+    { 0x76899, 1, { 0x0a } },  // ((0 | a) ^ a): MOV r0 0
+    { 0x76988, 1, { 0x09 } },  // ((a | 0) ^ 0): MOV r0 a
+    { 0x76989, 1, { 0x0a } },  // ((a | 0) ^ a): MOV r0 0
+    { 0x76998, 1, { 0x09 } },  // ((a | a) ^ 0): MOV r0 a
+    { 0x76999, 1, { 0x0a } },  // ((a | a) ^ a): MOV r0 0
+    { 0x769a8, 3, { 0x09, 0x59, 0x46 } },  // ((a | b) ^ 0): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x769a9, 4, { 0x09, 0x59, 0x45, 0x47 } },  // ((a | b) ^ a): MOV r0 a; MOV r1 b; AND r0 r1; XOR r0 r1
+    { 0x769aa, 4, { 0x09, 0x59, 0x15, 0x42 } },  // ((a | b) ^ b): MOV r0 a; MOV r1 b; AND r1 r0; SUB r0 r1
+    { 0x77888, 1, { 0x0a } },  // ((0 ^ 0) ^ 0): MOV r0 0
+    { 0x77889, 1, { 0x09 } },  // ((0 ^ 0) ^ a): MOV r0 a
+    { 0x77898, 1, { 0x09 } },  // ((0 ^ a) ^ 0): MOV r0 a
+    { 0x77899, 1, { 0x0a } },  // ((0 ^ a) ^ a): MOV r0 0
+    { 0x77988, 1, { 0x09 } },  // ((a ^ 0) ^ 0): MOV r0 a
+    { 0x77989, 1, { 0x0a } },  // ((a ^ 0) ^ a): MOV r0 0
+    { 0x77998, 1, { 0x0a } },  // ((a ^ a) ^ 0): MOV r0 0
+    { 0x77999, 1, { 0x09 } },  // ((a ^ a) ^ a): MOV r0 a
+    { 0x7799a, 1, { 0x49 } },  // ((a ^ a) ^ b): MOV r0 b
+    { 0x779a8, 3, { 0x09, 0x59, 0x47 } },  // ((a ^ b) ^ 0): MOV r0 a; MOV r1 b; XOR r0 r1
+    { 0x779a9, 1, { 0x49 } },  // ((a ^ b) ^ a): MOV r0 b
+    { 0x779aa, 1, { 0x09 } },  // ((a ^ b) ^ b): MOV r0 a
+    { 0x78188, 1, { 0x0a } },  // (0 ^ (0 + 0)): MOV r0 0
+    { 0x78189, 1, { 0x09 } },  // (0 ^ (0 + a)): MOV r0 a
+    { 0x78198, 1, { 0x09 } },  // (0 ^ (a + 0)): MOV r0 a
+    { 0x78199, 2, { 0x09, 0x01 } },  // (0 ^ (a + a)): MOV r0 a; ADD r0 r0
+    { 0x7819a, 3, { 0x09, 0x59, 0x41 } },  // (0 ^ (a + b)): MOV r0 a; MOV r1 b; ADD r0 r1
+    { 0x78288, 1, { 0x0a } },  // (0 ^ (0 - 0)): MOV r0 0
+    { 0x78289, 3, { 0x09, 0x9a, 0x43 } },  // (0 ^ (0 - a)): MOV r0 a; MOV r1 -1; MUL r0 r1
+    { 0x78298, 1, { 0x09 } },  // (0 ^ (a - 0)): MOV r0 a
+    { 0x78299, 1, { 0x0a } },  // (0 ^ (a - a)): MOV r0 0
+    { 0x7829a, 3, { 0x09, 0x59, 0x42 } },  // (0 ^ (a - b)): MOV r0 a; MOV r1 b; SUB r0 r1
+    { 0x78388, 1, { 0x0a } },  // (0 ^ (0 * 0)): MOV r0 0
+    { 0x78389, 1, { 0x0a } },  // (0 ^ (0 * a)): MOV r0 0
+    { 0x78398, 1, { 0x0a } },  // (0 ^ (a * 0)): MOV r0 0
+    { 0x78399, 2, { 0x09, 0x03 } },  // (0 ^ (a * a)): MOV r0 a; MUL r0 r0
+    { 0x7839a, 3, { 0x09, 0x59, 0x43 } },  // (0 ^ (a * b)): MOV r0 a; MOV r1 b; MUL r0 r1
+    { 0x78588, 1, { 0x0a } },  // (0 ^ (0 & 0)): MOV r0 0
+    { 0x78589, 1, { 0x0a } },  // (0 ^ (0 & a)): MOV r0 0
+    { 0x78598, 1, { 0x0a } },  // (0 ^ (a & 0)): MOV r0 0
+    { 0x78599, 1, { 0x09 } },  // (0 ^ (a & a)): MOV r0 a
+    { 0x7859a, 3, { 0x09, 0x59, 0x45 } },  // (0 ^ (a & b)): MOV r0 a; MOV r1 b; AND r0 r1
+    { 0x78688, 1, { 0x0a } },  // (0 ^ (0 | 0)): MOV r0 0
+    { 0x78689, 1, { 0x09 } },  // (0 ^ (0 | a)): MOV r0 a
+    { 0x78698, 1, { 0x09 } },  // (0 ^ (a | 0)): MOV r0 a
+    { 0x78699, 1, { 0x09 } },  // (0 ^ (a | a)): MOV r0 a
+    { 0x7869a, 3, { 0x09, 0x59, 0x46 } },  // (0 ^ (a | b)): MOV r0 a; MOV r1 b; OR r0 r1
+    { 0x78788, 1, { 0x0a } },  // (0 ^ (0 ^ 0)): MOV r0 0
+    { 0x78789, 1, { 0x09 } },  // (0 ^ (0 ^ a)): MOV r0 a
+    { 0x78798, 1, { 0x09 } },  // (0 ^ (a ^ 0)): MOV r0 a
+    { 0x78799, 1, { 0x0a } },  // (0 ^ (a ^ a)): MOV r0 0
+    { 0x7879a, 3, { 0x09, 0x59, 0x47 } },  // (0 ^ (a ^ b)): MOV r0 a; MOV r1 b; XOR r0 r1
+    { 0x79188, 1, { 0x09 } },  // (a ^ (0 + 0)): MOV r0 a
+    { 0x79189, 1, { 0x0a } },  // (a ^ (0 + a)): MOV r0 0
+    { 0x79198, 1, { 0x0a } },  // (a ^ (a + 0)): MOV r0 0
+    { 0x7919a, 4, { 0x09, 0x59, 0x11, 0x47 } },  // (a ^ (a + b)): MOV r0 a; MOV r1 b; ADD r1 r0; XOR r0 r1
+    { 0x791a9, 4, { 0x09, 0x59, 0x11, 0x47 } },  // (a ^ (b + a)): MOV r0 a; MOV r1 b; ADD r1 r0; XOR r0 r1
+    { 0x79288, 1, { 0x09 } },  // (a ^ (0 - 0)): MOV r0 a
+    { 0x79289, 4, { 0x09, 0x1a, 0x12, 0x47 } },  // (a ^ (0 - a)): MOV r0 a; MOV r1 0; SUB r1 r0; XOR r0 r1
+    { 0x79298, 1, { 0x0a } },  // (a ^ (a - 0)): MOV r0 0
+    { 0x79299, 1, { 0x09 } },  // (a ^ (a - a)): MOV r0 a
+    { 0x792a9, 4, { 0x09, 0x59, 0x12, 0x47 } },  // (a ^ (b - a)): MOV r0 a; MOV r1 b; SUB r1 r0; XOR r0 r1
+    { 0x792aa, 1, { 0x09 } },  // (a ^ (b - b)): MOV r0 a
+    { 0x79388, 1, { 0x09 } },  // (a ^ (0 * 0)): MOV r0 a
+    { 0x79389, 1, { 0x09 } },  // (a ^ (0 * a)): MOV r0 a
+    { 0x7938a, 1, { 0x09 } },  // (a ^ (0 * b)): MOV r0 a
+    { 0x79398, 1, { 0x09 } },  // (a ^ (a * 0)): MOV r0 a
+    { 0x7939a, 4, { 0x09, 0x59, 0x13, 0x47 } },  // (a ^ (a * b)): MOV r0 a; MOV r1 b; MUL r1 r0; XOR r0 r1
+    { 0x793a8, 1, { 0x09 } },  // (a ^ (b * 0)): MOV r0 a
+    { 0x793a9, 4, { 0x09, 0x59, 0x13, 0x47 } },  // (a ^ (b * a)): MOV r0 a; MOV r1 b; MUL r1 r0; XOR r0 r1
+    { 0x79588, 1, { 0x09 } },  // (a ^ (0 & 0)): MOV r0 a
+    { 0x79589, 1, { 0x09 } },  // (a ^ (0 & a)): MOV r0 a
+    { 0x7958a, 1, { 0x09 } },  // (a ^ (0 & b)): MOV r0 a
+    { 0x79598, 1, { 0x09 } },  // (a ^ (a & 0)): MOV r0 a
+    { 0x79599, 1, { 0x0a } },  // (a ^ (a & a)): MOV r0 0
+    { 0x7959a, 4, { 0x09, 0x59, 0x15, 0x42 } },  // (a ^ (a & b)): MOV r0 a; MOV r1 b; AND r1 r0; SUB r0 r1
+    { 0x795a8, 1, { 0x09 } },  // (a ^ (b & 0)): MOV r0 a
+    { 0x795a9, 4, { 0x09, 0x59, 0x15, 0x42 } },  // (a ^ (b & a)): MOV r0 a; MOV r1 b; AND r1 r0; SUB r0 r1
+    { 0x79688, 1, { 0x09 } },  // (a ^ (0 | 0)): MOV r0 a
+    { 0x79689, 1, { 0x0a } },  // (a ^ (0 | a)): MOV r0 0
+    { 0x79698, 1, { 0x0a } },  // (a ^ (a | 0)): MOV r0 0
+    { 0x79699, 1, { 0x0a } },  // (a ^ (a | a)): MOV r0 0
+    { 0x7969a, 4, { 0x09, 0x59, 0x45, 0x47 } },  // (a ^ (a | b)): MOV r0 a; MOV r1 b; AND r0 r1; XOR r0 r1
+    { 0x796a9, 4, { 0x09, 0x59, 0x45, 0x47 } },  // (a ^ (b | a)): MOV r0 a; MOV r1 b; AND r0 r1; XOR r0 r1
+    { 0x79788, 1, { 0x09 } },  // (a ^ (0 ^ 0)): MOV r0 a
+    { 0x79789, 1, { 0x0a } },  // (a ^ (0 ^ a)): MOV r0 0
+    { 0x79798, 1, { 0x0a } },  // (a ^ (a ^ 0)): MOV r0 0
+    { 0x79799, 1, { 0x09 } },  // (a ^ (a ^ a)): MOV r0 a
+    { 0x7979a, 1, { 0x49 } },  // (a ^ (a ^ b)): MOV r0 b
+    { 0x797a9, 1, { 0x49 } },  // (a ^ (b ^ a)): MOV r0 b
+    { 0x797aa, 1, { 0x09 } },  // (a ^ (b ^ b)): MOV r0 a
+};